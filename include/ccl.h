@@ -22,6 +22,7 @@
 
 #include "ccl_defs.h"
 #include "ccl_utils.h"
+#include "ccl_table.h"
 #include "ccl_config.h"
 #include "ccl_core.h"
 #include "ccl_error.h"
@@ -28,10 +28,19 @@ typedef struct {
   double chimin;
   double zmin; //Limits in chi where we care about this tracer
   double zmax;
+  double nz_zmin; //Limits in z where the input N(z) is relevant
+  double nz_zmax;
+  double nz_mean; //Mean redshift of the input N(z)
+  double nz_shift; //Photo-z shift applied to N(z)
+  double nz_stretch; //Photo-z stretch applied to N(z) around its mean
+  double z_source; //Redshift of the source (for CMB lensing)
   double chi_source; //Comoving distance to the source (for CMB lensing)
+  int has_density; //0 only for the RSD and magnification bias templates (see ccl_angular_cls_bias_templates)
   int has_rsd;
   int has_magnification;
   int has_intrinsic_alignment;
+  double bz_zmin; //Redshift range of the unit-bias density templates (only used if spl_bz is NULL)
+  double bz_zmax;
   SplPar *spl_nz; //Spline for normalized N(z)
   SplPar *spl_bz; //Spline for linear bias
   SplPar *spl_sz; //Spline for magnification bias
@@ -40,6 +49,7 @@ typedef struct {
   SplPar *spl_wL; //Spline for lensing kernel
   SplPar *spl_wM; //Spline for magnification
   int computed_transfer;
+  int transfer_method; //Non-Limber method used to compute spl_transfer
   int n_ls;
   int *n_k;
   SplPar **spl_transfer;
@@ -166,6 +176,38 @@ CCL_ClTracer *ccl_cl_tracer_lensing_simple(ccl_cosmology *cosmo,
  */
 CCL_ClTracer *ccl_cl_tracer_cmblens(ccl_cosmology *cosmo,double z_source,int *status);
 
+/**
+ * Re-binds an existing ClTracer to a new cosmology.
+ * Only the quantities that depend on the cosmology (limits in comoving distance and
+ * lensing/magnification windows) are recomputed, reusing the memory allocated for them.
+ * The redshift-dependent inputs (N(z), b(z), s(z), IA) are kept as they were at construction.
+ * Any transfer functions computed for the previous cosmology are discarded.
+ * @param cosmo Cosmological parameters
+ * @param clt a ClTracer
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_cl_tracer_rebind(ccl_cosmology *cosmo,CCL_ClTracer *clt,int *status);
+
+/**
+ * Sets the photo-z shift and stretch of the redshift distribution of a ClTracer.
+ * The redshift distribution used by the tracer becomes
+ * N'(z) = N(<z>+(z-<z>-dz)/stretch)/stretch, where N(z) is the distribution passed
+ * at construction and <z> its mean. The input N(z) spline is not modified, and only
+ * the limits in comoving distance and the lensing/magnification windows are recomputed.
+ * Any transfer functions computed for the previous parameters are discarded.
+ * @param cosmo Cosmological parameters
+ * @param clt a number counts or weak lensing ClTracer
+ * @param dz Shift in the mean redshift
+ * @param stretch Stretch factor of the width of N(z) around its mean (must be positive)
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_cl_tracer_set_photoz(ccl_cosmology *cosmo,CCL_ClTracer *clt,
+			      double dz,double stretch,int *status);
+
 /**
  * Destructor for a Cltracer
  * @param clt a Cltracer
@@ -208,9 +250,16 @@ int ccl_get_tracer_fas(ccl_cosmology *cosmo,CCL_ClTracer *clt,int na,double *a,d
 
 #define CCL_NONLIMBER_METHOD_NATIVE 1
 #define CCL_NONLIMBER_METHOD_ANGPOW 2
+#define CCL_NONLIMBER_METHOD_FFTLOG 3 //Spherical Bessel transforms of the radial kernels with FFTLog
+#define CCL_NONLIMBER_METHOD_LEVIN 4 //Adaptive Levin integration over chi for each multipole and wavenumber
+#define CCL_LIMBER_METHOD_QAG 1 //Adaptive integration over k for each multipole
+#define CCL_LIMBER_METHOD_GRID 2 //Sums over a fixed grid in chi shared by all multipoles
+#define CCL_LIMBER_GRID_DLCHI 0.005 //Default logarithmic (base 10) spacing of the chi grid
 //Workspace for C_ell computations
 typedef struct {
   int nlimb_method;
+  int limber_method; //Method used for the Limber integrals (QAG by default)
+  double dlchi; //Logarithmic (base 10) spacing in comoving distance used by CCL_LIMBER_METHOD_GRID
   double zmin;
   double dchi; //Spacing in comoving distance to use for the LOS integrals
   double dlk; //Logarithmic spacing in wavenumber
@@ -220,6 +269,8 @@ typedef struct {
   int l_linstep; //Linear step used at high l
   int n_ls; //Number of multipoles that result from the previous combination of parameters
   int *l_arr; //Array of multipole values resulting from the previous parameters
+  double l_epsrel; //If positive, the C_ells are only computed at the subset of l_arr needed to
+                   //interpolate them with this relative accuracy (0 by default: all of l_arr)
 } CCL_ClWorkspace;
 
 //CCL_ClWorkspace constructor
@@ -248,6 +299,100 @@ void ccl_angular_cls(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
 		     CCL_ClTracer *clt1,CCL_ClTracer *clt2,
 		     int nl_out,int *l,double *cl,int *status);
 
+/**
+ * Computes limber or non-limber power spectra for a set of pairs of tracers.
+ * With CCL_LIMBER_METHOD_GRID, the background quantities and the power spectrum
+ * needed by the Limber integrals are evaluated once and shared by all pairs.
+ * @param cosmo Cosmological parameters
+ * @param w a ClWorkspace
+ * @param ntracers number of tracers
+ * @param tracers array of ntracers Cltracers
+ * @param npairs number of pairs of tracers
+ * @param pair1 index in tracers of the first tracer of each of the npairs pairs
+ * @param pair2 index in tracers of the second tracer of each of the npairs pairs
+ * @param nl_out the number of ell values
+ * @param l an array of ell values
+ * @param cl the C_ell output array, of size npairs*nl_out. The power spectrum of pair ip
+ * at l[il] is stored in cl[ip*nl_out+il]
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_angular_cls_matrix(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+			    int ntracers,CCL_ClTracer **tracers,
+			    int npairs,int *pair1,int *pair2,
+			    int nl_out,int *l,double *cl,int *status);
+
+/**
+ * Computes bandpowers of limber or non-limber power spectra for a set of pairs of tracers.
+ * The bandpower windows are passed as a sparse matrix in compressed sparse row (CSR) format:
+ * bandpower ib is the sum of w_b[j]*C_{l_b[j]} for band_ptr[ib] <= j < band_ptr[ib+1].
+ * The power spectra are computed only at the interpolation nodes needed, and interpolated
+ * once into the multipoles spanned by the windows.
+ * @param cosmo Cosmological parameters
+ * @param w a ClWorkspace. Its lmax must be larger than all the multipoles in l_b
+ * @param ntracers number of tracers
+ * @param tracers array of ntracers Cltracers
+ * @param npairs number of pairs of tracers
+ * @param pair1 index in tracers of the first tracer of each of the npairs pairs
+ * @param pair2 index in tracers of the second tracer of each of the npairs pairs
+ * @param nb number of bandpowers
+ * @param band_ptr array of nb+1 row offsets into l_b and w_b, with band_ptr[0]=0
+ * @param l_b multipole of each of the band_ptr[nb] non-zero window entries
+ * @param w_b weight of each of the band_ptr[nb] non-zero window entries
+ * @param cb the bandpower output array, of size npairs*nb. Bandpower ib of pair ip
+ * is stored in cb[ip*nb+ib]
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_angular_cls_bandpowers(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				int ntracers,CCL_ClTracer **tracers,
+				int npairs,int *pair1,int *pair2,
+				int nb,int *band_ptr,int *l_b,double *w_b,
+				double *cb,int *status);
+
+/**
+ * Number of bias templates of a ClTracer (see ccl_angular_cls_bias_templates).
+ * This is nzb, plus one if the tracer has RSD, plus one if it has magnification, for
+ * number counts tracers, and 1 for any other tracer.
+ * @param clt a ClTracer
+ * @param nzb number of redshift bins of the galaxy bias
+ * @return number of templates
+ */
+int ccl_cl_tracer_n_bias_templates(CCL_ClTracer *clt,int nzb);
+
+/**
+ * Computes the angular power spectra between the bias templates of two tracers.
+ * The transfer function of a number counts tracer is linear in a galaxy bias that is
+ * piecewise constant in nzb redshift bins, so that it can be written as
+ * sum_i c_i T_i, where the templates T_i are, in this order: the density term with unit
+ * bias in each redshift bin, the RSD term (if present) and the magnification term (if
+ * present), and the coefficients c_i are the bias in each bin followed by ones.
+ * Any other tracer is its own single template. The power spectrum between two tracers
+ * is then C_ell = sum_ij c1_i c2_j C_ell^ij, which can be recomputed for new values of
+ * the bias without any further integral. The bias b(z) of the tracers is ignored.
+ * @param cosmo Cosmological parameters
+ * @param w a ClWorkspace
+ * @param clt1 a Cltracer
+ * @param clt2 a Cltracer
+ * @param nzb number of redshift bins of the galaxy bias
+ * @param z_edges array of nzb+1 increasing bin edges. If NULL, nzb must be 1 and the
+ * single density template has unit bias at all redshifts.
+ * @param nl_out the number of ell values
+ * @param l an array of ell values
+ * @param cl the C_ell output array, of size n1*n2*nl_out, where n1 and n2 are the numbers
+ * of templates of each tracer (see ccl_cl_tracer_n_bias_templates). The power spectrum
+ * between templates i1 and i2 at l[il] is stored in cl[(i1*n2+i2)*nl_out+il]
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_angular_cls_bias_templates(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				    CCL_ClTracer *clt1,CCL_ClTracer *clt2,
+				    int nzb,double *z_edges,
+				    int nl_out,int *l,double *cl,int *status);
+
 CCL_END_DECLS
 
 
@@ -105,7 +105,9 @@ typedef enum emulator_neutrinos_t
  * Configuration typedef.
  * This contains the transfer function,
  * matter power spectrum, and mass function
- * that is being used currently.
+ * that is being used currently, as well as the
+ * number of OpenMP threads used to compute the
+ * power spectrum tables and the angular power spectra.
  */
 typedef struct ccl_configuration {
   transfer_function_t      transfer_function_method;
@@ -114,6 +116,7 @@ typedef struct ccl_configuration {
   mass_function_t          mass_function_method;
   halo_concentration_t     halo_concentration_method;
   emulator_neutrinos_t     emulator_neutrinos_method;
+  int                      n_threads; // Number of OpenMP threads (0: OpenMP default)
   // TODO: Halo definition
 } ccl_configuration;
 
@@ -112,6 +112,12 @@
 
 
 //Precision parameters
+/**
+ * Default spacing (in Mpc) of the a(chi) spline nodes, used if
+ * CHI_SPLINE_DELTA is missing from the parameter file
+ */
+#define CHI_SPLINE_DELTA_DEFAULT 5.0
+
 /**
  * Default relative precision if not otherwise specified
  */
@@ -154,6 +160,18 @@
  */
 #define GSL_EPSREL_DIST 1E-6
 
+/**
+ * Order of the Gauss-Legendre rule used on each panel of the cumulative
+ * comoving distance integral
+ */
+#define CHI_GL_ORDER 8
+
+/**
+ * Maximum number of bisections of a single panel of the cumulative
+ * comoving distance integral
+ */
+#define CHI_GL_MAX_DEPTH 20
+
 /**
  * Relative precision in growth calculations
  */
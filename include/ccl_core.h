@@ -84,21 +84,23 @@ typedef struct ccl_data{
   gsl_spline * fgrowth;
   gsl_spline * E;
   gsl_spline * achi;
+  // O(1) lookup tables reproducing the splines above, used for evaluation
+  ccl_table1d * tab_chi;
+  ccl_table1d * tab_growth;
+  ccl_table1d * tab_fgrowth;
+  ccl_table1d * tab_E;
+  ccl_table1d * tab_achi;
 
-  // All these splines use the same accelerator so that
-  // if one calls them successively with the same a value
-  // they will be much faster.
-  gsl_interp_accel *accelerator;
-  gsl_interp_accel *accelerator_achi;
-  gsl_interp_accel *accelerator_m;
-  gsl_interp_accel *accelerator_d;
-  //TODO: it seems like we're not really using this accelerator, and we should
-  gsl_interp_accel *accelerator_k;
+  // No interpolation accelerators are stored here: all lookups into these
+  // splines are read-only, so a computed cosmology can be evaluated
+  // concurrently from several threads.
 
   // Function of Halo mass M
 
   gsl_spline * logsigma;
   gsl_spline * dlnsigma_dlogm;
+  ccl_table1d * tab_logsigma;
+  ccl_table1d * tab_dlnsigma_dlogm;
 
   // splines for halo mass function
   gsl_spline * alphahmf;
@@ -110,6 +112,8 @@ typedef struct ccl_data{
   // These are all functions of the wavenumber k and the scale factor a.
   gsl_spline2d * p_lin;
   gsl_spline2d * p_nl;
+  ccl_table2d * tab_p_lin;
+  ccl_table2d * tab_p_nl;
   double k_min_lin; //k_min  [1/Mpc] <- minimum wavenumber that the power spectrum has been computed to
   double k_min_nl;
   double k_max_lin;
@@ -118,6 +122,10 @@ typedef struct ccl_data{
 
 /**
  * Sturct containing references to instances of the above structs, and boolean flags of precomputed values.
+ * Evaluating a cosmology does not modify it once the tables involved have been computed
+ * (see ccl_cosmology_compute_distances, ccl_cosmology_compute_growth and ccl_cosmology_compute_power),
+ * so a computed cosmology can be used concurrently from several threads.
+ * The tables are computed lazily on first use, which must not happen from several threads at once.
  */
 typedef struct ccl_cosmology
 {
@@ -154,6 +162,9 @@ ccl_cosmology * ccl_cosmology_create(ccl_parameters params, ccl_configuration co
 /* Internal function to set the status message safely. */
 void ccl_cosmology_set_status_message(ccl_cosmology * cosmo, const char * status_message, ...);
 
+/* Internal function returning the number of OpenMP threads to use for this cosmology. */
+int ccl_cosmology_num_threads(ccl_cosmology * cosmo);
+
 
 // User-facing creation routines
 /**
@@ -17,5 +17,39 @@ CCL_BEGIN_DECLS
  */
 void ccl_pkemu(double *xstarin, double **Pkemu, int *status, ccl_cosmology* cosmo);
 
+/**
+ * Emulator power spectrum at several redshifts
+ * Obtain P(k,z) [Mpc^3] for a given set of cosmological parameters at nz redshifts.
+ * The cosmology-dependent part of the emulation is only done once.
+ * @param xstarin vector of the 8 cosmological input parameters for the emulator (without redshift).
+ * @param nz number of redshifts
+ * @param zstar redshifts at which the power spectrum is requested.
+ * @param Pkemu output P(k,z) power spectrum, with size nz*NK_EMU and
+ *        Pkemu[iz*NK_EMU+ik] corresponding to the ik-th emulator k and zstar[iz].
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * @param cosmo Cosmology parameters and configurations (only relevant for storing status)
+ */
+void ccl_pkemu_multiz(double *xstarin, int nz, double *zstar, double *Pkemu, int *status, ccl_cosmology *cosmo);
+
+/**
+ * Emulator power spectrum for several cosmologies
+ * Obtain P(k,z) [Mpc^3] for ncosmo sets of cosmological parameters at nz redshifts.
+ * The emulation is carried out for all cosmologies at once, in terms of dense
+ * matrix products. This is much faster than calling ccl_pkemu_multiz() for each
+ * cosmology when ncosmo is large.
+ * @param ncosmo number of cosmologies
+ * @param xstarin array of ncosmo*8 cosmological input parameters for the emulator
+ *        (without redshift), with the parameters of each cosmology contiguous.
+ * @param nz number of redshifts
+ * @param zstar redshifts at which the power spectrum is requested.
+ * @param Pkemu output P(k,z) power spectra, with size ncosmo*nz*NK_EMU and
+ *        Pkemu[(ic*nz+iz)*NK_EMU+ik] corresponding to the ic-th cosmology,
+ *        the ik-th emulator k and zstar[iz]. The spectra of a cosmology outside
+ *        the emulator bounds are set to NAN; the other cosmologies are unaffected.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * @param cosmo Cosmology parameters and configurations (only relevant for storing status)
+ */
+void ccl_pkemu_batch(int ncosmo, double *xstarin, int nz, double *zstar, double *Pkemu, int *status, ccl_cosmology *cosmo);
+
 CCL_END_DECLS
 #endif
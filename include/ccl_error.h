@@ -37,6 +37,7 @@ CCL_BEGIN_DECLS
 #define CCL_ERROR_LOGSPACE 1052
 #define CCL_ERROR_LINLOGSPACE 1053
 #define CCL_ERROR_CONFIG_FILE 1054
+#define CCL_ERROR_EMULATOR 1055
 
 typedef enum {
   CCL_ERROR_POLICY_EXIT = 0,
@@ -19,6 +19,9 @@ typedef struct ccl_spline_params {
   double A_SPLINE_MINLOG;
   int A_SPLINE_NLOG;
 
+  //Comoving distance spline (a(chi))
+  double CHI_SPLINE_DELTA;
+
   //Mass splines
   double LOGM_SPLINE_DELTA;
   int LOGM_SPLINE_NM;
@@ -53,6 +53,64 @@ double ccl_linear_matter_power(ccl_cosmology * cosmo, double k, double a,int * s
 
 double ccl_nonlin_matter_power(ccl_cosmology * cosmo, double k, double a,int * status);
 
+/**
+ * Linear matter power spectrum at an array of (k,a) pairs.
+ * Equivalent to calling ccl_linear_matter_power() for each pair, but
+ * evaluates the P(k,a) table in a single pass.
+ * @param cosmo Cosmology parameters and configurations
+ * @param n number of points
+ * @param k Fourier modes, in [1/Mpc] units
+ * @param a scale factors, normalized to 1 for today
+ * @param output array of n P_lin(k,a) values
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_linear_matter_powers(ccl_cosmology * cosmo, int n, double k[], double a[],
+			      double output[], int * status);
+
+/**
+ * Linear matter power spectrum at an array of k for a single scale factor.
+ * The cells of the P(k,a) table containing a are only interpolated once.
+ * @param cosmo Cosmology parameters and configurations
+ * @param a scale factor, normalized to 1 for today
+ * @param nk number of Fourier modes
+ * @param k Fourier modes, in [1/Mpc] units
+ * @param output array of nk P_lin(k,a) values
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_linear_matter_powers_at_a(ccl_cosmology * cosmo, double a, int nk, double k[],
+				   double output[], int * status);
+
+/**
+ * Non-linear matter power spectrum at an array of (k,a) pairs.
+ * Equivalent to calling ccl_nonlin_matter_power() for each pair, but
+ * evaluates the P(k,a) table in a single pass.
+ * @param cosmo Cosmology parameters and configurations
+ * @param n number of points
+ * @param k Fourier modes, in [1/Mpc] units
+ * @param a scale factors, normalized to 1 for today
+ * @param output array of n P_NL(k,a) values
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_nonlin_matter_powers(ccl_cosmology * cosmo, int n, double k[], double a[],
+			      double output[], int * status);
+
+/**
+ * Non-linear matter power spectrum at an array of k for a single scale factor.
+ * The cells of the P(k,a) table containing a are only interpolated once.
+ * @param cosmo Cosmology parameters and configurations
+ * @param a scale factor, normalized to 1 for today
+ * @param nk number of Fourier modes
+ * @param k Fourier modes, in [1/Mpc] units
+ * @param output array of nk P_NL(k,a) values
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_nonlin_matter_powers_at_a(ccl_cosmology * cosmo, double a, int nk, double k[],
+				   double output[], int * status);
+
 
 /**
  * Compute the power spectrum and create a 2d spline P(k,z) to be stored
@@ -0,0 +1,133 @@
+/** @file */
+#ifndef __CCL_TABLE_H_INCLUDED__
+#define __CCL_TABLE_H_INCLUDED__
+
+#include <gsl/gsl_spline.h>
+#include <gsl/gsl_spline2d.h>
+
+CCL_BEGIN_DECLS
+
+/**
+ * Grid of nodes along one dimension of a table.
+ * The grids used by CCL are piecewise uniform: logarithmically spaced up to
+ * some node and linearly spaced after it (either segment can be empty).
+ * When that structure is detected, the cell containing a given point is
+ * found arithmetically instead of through a bisection.
+ */
+typedef struct {
+  int n; //Number of nodes
+  double *x; //Nodes
+  int uniform; //1 if the grid is piecewise uniform, 0 if a bisection is needed
+  int ilin; //Index of the first node of the linearly-spaced segment
+  double lx0,idlx; //log(x[0]) and inverse logarithmic step of the log-spaced segment
+  double xlin,idx; //First node and inverse step of the linearly-spaced segment
+} ccl_table_axis;
+
+/**
+ * 1D interpolation table.
+ * Stores the cubic polynomial of each cell contiguously, in powers of the
+ * fractional position within the cell.
+ */
+typedef struct {
+  ccl_table_axis ax;
+  double *c; //4 coefficients per cell
+} ccl_table1d;
+
+/**
+ * 2D interpolation table.
+ * Stores the 16 bicubic coefficients of each cell contiguously. Cells with the
+ * same y index are contiguous in memory.
+ */
+typedef struct {
+  ccl_table_axis ax_x;
+  ccl_table_axis ax_y;
+  double *c; //16 coefficients per cell
+} ccl_table2d;
+
+/**
+ * Create a 1D table reproducing a GSL spline.
+ * The spline must be continuous in its first derivative (e.g. cubic or Akima).
+ * @param spl spline to tabulate
+ * @return ccl_table1d object, or NULL if it couldn't be allocated.
+ */
+ccl_table1d *ccl_table1d_new(gsl_spline *spl);
+
+/**
+ * Evaluate a 1D table.
+ * @param tab table
+ * @param x point at which to evaluate it
+ * @param y output value
+ * @return GSL_SUCCESS, or GSL_EDOM if x is outside the table range.
+ */
+int ccl_table1d_eval_e(const ccl_table1d *tab,double x,double *y);
+
+/**
+ * Evaluate a 1D table over an array of points.
+ * Points outside the table range are set to NAN.
+ * @param tab table
+ * @param n number of points
+ * @param x points at which to evaluate it
+ * @param y output values
+ * @return GSL_SUCCESS, or GSL_EDOM if any point is outside the table range.
+ */
+int ccl_table1d_eval_array(const ccl_table1d *tab,int n,const double *x,double *y);
+
+/**
+ * 1D table destructor.
+ * @param tab table (can be NULL)
+ * @return void
+ */
+void ccl_table1d_free(ccl_table1d *tab);
+
+/**
+ * Create a 2D table reproducing a bicubic GSL 2D spline.
+ * @param spl spline to tabulate
+ * @return ccl_table2d object, or NULL if it couldn't be allocated.
+ */
+ccl_table2d *ccl_table2d_new(gsl_spline2d *spl);
+
+/**
+ * Evaluate a 2D table.
+ * @param tab table
+ * @param x first coordinate
+ * @param y second coordinate
+ * @param z output value
+ * @return GSL_SUCCESS, or GSL_EDOM if (x,y) is outside the table range.
+ */
+int ccl_table2d_eval_e(const ccl_table2d *tab,double x,double y,double *z);
+
+/**
+ * Evaluate a 2D table at an array of (x,y) pairs.
+ * Points outside the table range are set to NAN.
+ * @param tab table
+ * @param n number of points
+ * @param x first coordinates
+ * @param y second coordinates
+ * @param z output values
+ * @return GSL_SUCCESS, or GSL_EDOM if any point is outside the table range.
+ */
+int ccl_table2d_eval_array(const ccl_table2d *tab,int n,const double *x,const double *y,double *z);
+
+/**
+ * Evaluate a 2D table at an array of x for a fixed value of y.
+ * The row of cells containing y is only located and interpolated once.
+ * Points outside the table range are set to NAN.
+ * @param tab table
+ * @param y second coordinate, common to all points
+ * @param n number of points
+ * @param x first coordinates
+ * @param z output values
+ * @return GSL_SUCCESS, or GSL_EDOM if any point is outside the table range.
+ */
+int ccl_table2d_eval_fixed_y(const ccl_table2d *tab,double y,int n,const double *x,double *z);
+
+/**
+ * 2D table destructor.
+ * @param tab table (can be NULL)
+ * @return void
+ */
+void ccl_table2d_free(ccl_table2d *tab);
+
+CCL_END_DECLS
+
+#endif
@@ -42,12 +42,64 @@ double * ccl_log_spacing(double xmin, double xmax, int N);
 double ccl_j_bessel(int l,double x);
 //Spherical Bessel function of order l (adapted from CAMB)
 
+/**
+ * Table of spherical Bessel functions j_l(x) for a range of orders, on a uniform grid in x.
+ * Values and derivatives are stored at the nodes and interpolated with cubic Hermite
+ * polynomials, so that the interpolation error is ~dx^4/384.
+ */
+typedef struct {
+  int lmin; //Lowest order
+  int nl; //Number of orders (lmin to lmin+nl-1)
+  int nx; //Number of nodes in x
+  double dx,idx; //Spacing of the nodes and its inverse
+  double xmax; //Last node
+  double *jl; //j_l at the nodes. Order l starts at jl[(l-lmin)*nx]
+  double *djl; //Derivative of j_l times dx, with the same layout
+} ccl_bessel_table;
+
+/**
+ * Create a table of spherical Bessel functions.
+ * @param lmin lowest order
+ * @param nl number of orders
+ * @param xmax maximum argument covered by the table
+ * @param dx spacing of the grid in x
+ * @return ccl_bessel_table object, or NULL if the arguments are invalid or it couldn't be allocated.
+ */
+ccl_bessel_table *ccl_bessel_table_new(int lmin,int nl,double xmax,double dx);
+
+/**
+ * Evaluate j_l(x) from a table. Arguments outside [0,xmax] are computed with ccl_j_bessel.
+ * @param tab table
+ * @param l order, which must be one of the orders of the table
+ * @param x argument
+ * @return j_l(x)
+ */
+double ccl_bessel_table_eval(const ccl_bessel_table *tab,int l,double x);
+
+/**
+ * Evaluate j_l(x) from a table over an array of arguments.
+ * @param tab table
+ * @param l order, which must be one of the orders of the table
+ * @param n number of points
+ * @param x arguments
+ * @param jl output values
+ * @return void
+ */
+void ccl_bessel_table_eval_array(const ccl_bessel_table *tab,int l,int n,const double *x,double *jl);
+
+/**
+ * Bessel table destructor.
+ * @param tab table (can be NULL)
+ * @return void
+ */
+void ccl_bessel_table_free(ccl_bessel_table *tab);
+
 /**
  * Spline wrapper
- * Used to take care of evaluations outside the supported range
+ * Used to take care of evaluations outside the supported range.
+ * Evaluation does not modify the wrapper, so a SplPar can be shared between threads.
  */
 typedef struct {
-  gsl_interp_accel *intacc; //GSL spline
   gsl_spline *spline;
   double x0,xf; //Interpolation limits
   double y0,yf; //Constant values to use beyond interpolation limit
@@ -55,6 +107,8 @@ typedef struct {
 
 SplPar *ccl_spline_init(int n,double *x,double *y,double y0,double yf);
 
+SplPar *ccl_spline_reinit(SplPar *spl,int n,double *x,double *y,double y0,double yf);
+
 double ccl_spline_eval(double x,SplPar *spl);
 
 void ccl_spline_free(SplPar *spl);
@@ -38,7 +38,7 @@ from .power import linear_matter_power, nonlin_matter_power, sigmaR, \
 from .massfunction import massfunc, massfunc_m2r, sigmaM, halo_bias
 
 # Cl's and tracers
-from .cls import angular_cl, NumberCountsTracer, WeakLensingTracer, CMBLensingTracer
+from .cls import angular_cl, angular_cl_matrix, angular_cl_bias_templates, angular_cl_bandpowers, NumberCountsTracer, WeakLensingTracer, CMBLensingTracer
 
 from .lsst_specs import bias_clustering, sigmaz_clustering, \
     sigmaz_sources, dNdz_tomog, PhotoZFunction, PhotoZGaussian
@@ -4,6 +4,32 @@
 /* put additional #include here */
 %}
 
+// Convert a sequence of tracers into an array of pointers
+%typemap(in) (int ntracers, CCL_ClTracer **tracers) {
+    if (!PySequence_Check($input)) {
+        PyErr_SetString(PyExc_TypeError, "Expected a sequence of tracers");
+        SWIG_fail;
+    }
+    $1 = (int)PySequence_Size($input);
+    $2 = (CCL_ClTracer **)malloc($1 * sizeof(CCL_ClTracer *));
+    if ($2 == NULL) {
+        PyErr_NoMemory();
+        SWIG_fail;
+    }
+    for (int i = 0; i < $1; i++) {
+        PyObject *o = PySequence_GetItem($input, i);
+        int res = SWIG_ConvertPtr(o, (void **)&($2[i]), $descriptor(CCL_ClTracer *), 0);
+        Py_XDECREF(o);
+        if (!SWIG_IsOK(res)) {
+            PyErr_SetString(PyExc_TypeError, "Expected a sequence of tracers");
+            SWIG_fail;
+        }
+    }
+}
+%typemap(freearg) (int ntracers, CCL_ClTracer **tracers) {
+    free($2);
+}
+
 %include "../include/ccl_cls.h"
 
 // Enable vectorised arguments for arrays
@@ -20,7 +46,11 @@
     (double* rf, int nrf)}
 %apply (double* IN_ARRAY1, int DIM1) {
     (double* ell, int nell),
-    (double* aarr, int na)};
+    (double* z_edges, int nzedges),
+    (double* aarr, int na),
+    (double* band_ptr, int nptr),
+    (double* band_ell, int nbell),
+    (double* band_w, int nbw)};
 %apply (int DIM1, double* ARGOUT_ARRAY1) {(int nout, double* output)};
 
 
@@ -77,7 +107,7 @@ CCL_ClTracer* cl_tracer_new_wrapper(ccl_cosmology *cosmo, int tracer_type,
 void angular_cl_vec(ccl_cosmology * cosmo, CCL_ClTracer *clt1, CCL_ClTracer *clt2,
                     double l_limber, double l_logstep, double l_linstep,
                     double dchi, double dlk, double zmin, int method,
-                    double* ell, int nell, int nout, double* output, int *status) {
+                    int limber_method, double l_epsrel, double* ell, int nell, int nout, double* output, int *status) {
   //Cast ells as integers
   int *ell_int = malloc(nell * sizeof(int));
   CCL_ClWorkspace *w = ccl_cl_workspace_default(
@@ -90,6 +120,10 @@ void angular_cl_vec(ccl_cosmology * cosmo, CCL_ClTracer *clt1, CCL_ClTracer *clt
         dlk,
         zmin,
         status);
+  if (*status == 0) {
+    w->limber_method = limber_method;
+    w->l_epsrel = l_epsrel;
+  }
 
   for(int i=0; i < nell; i++)
     ell_int[i] = (int)(ell[i]);
@@ -103,6 +137,175 @@ void angular_cl_vec(ccl_cosmology * cosmo, CCL_ClTracer *clt1, CCL_ClTracer *clt
 
 %}
 
+%feature("pythonprepend") angular_cl_matrix_vec %{
+    if nout != len(tracers) * (len(tracers) + 1) // 2 * numpy.size(ell):
+        raise CCLError("Input shape for `ell` must match the number of pairs!")
+%}
+
+%inline %{
+
+void angular_cl_matrix_vec(ccl_cosmology * cosmo, int ntracers, CCL_ClTracer **tracers,
+                           double l_limber, double l_logstep, double l_linstep,
+                           double dchi, double dlk, double zmin, int method,
+                           int limber_method, double l_epsrel, double* ell, int nell,
+                           int nout, double* output, int *status) {
+  //All pairs of tracers (i1 <= i2), in row-major order
+  int npairs = ntracers * (ntracers + 1) / 2;
+  int *pair1 = malloc(2 * npairs * sizeof(int));
+  //Cast ells as integers
+  int *ell_int = malloc(nell * sizeof(int));
+  if ((pair1 == NULL) || (ell_int == NULL)) {
+    free(pair1);
+    free(ell_int);
+    *status = CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.i: angular_cl_matrix_vec(): ran out of memory\n");
+    return;
+  }
+  int *pair2 = pair1 + npairs;
+  int ip = 0;
+  for(int i1=0; i1 < ntracers; i1++) {
+    for(int i2=i1; i2 < ntracers; i2++) {
+      pair1[ip] = i1;
+      pair2[ip] = i2;
+      ip++;
+    }
+  }
+
+  CCL_ClWorkspace *w = ccl_cl_workspace_default(
+        (int)(ell[nell - 1]) + 1,
+        (int)l_limber,
+        method,
+        l_logstep,
+        (int)l_linstep,
+        dchi,
+        dlk,
+        zmin,
+        status);
+  if (*status == 0) {
+    w->limber_method = limber_method;
+    w->l_epsrel = l_epsrel;
+  }
+
+  for(int i=0; i < nell; i++)
+    ell_int[i] = (int)(ell[i]);
+
+  //Compute C_ells
+  if (*status == 0)
+    ccl_angular_cls_matrix(cosmo, w, ntracers, tracers, npairs, pair1, pair2,
+                           nell, ell_int, output, status);
+
+  free(ell_int);
+  free(pair1);
+  if (w != NULL)
+    ccl_cl_workspace_free(w);
+}
+
+%}
+
+%inline %{
+
+void angular_cl_bias_templates_vec(ccl_cosmology * cosmo, CCL_ClTracer *clt1, CCL_ClTracer *clt2,
+                                   double* z_edges, int nzedges,
+                                   double l_limber, double l_logstep, double l_linstep,
+                                   double dchi, double dlk, double zmin, int method,
+                                   int limber_method, double l_epsrel, double* ell, int nell,
+                                   int nout, double* output, int *status) {
+  //An empty array of bin edges means a single bin covering all redshifts
+  int nzb = (nzedges > 0) ? nzedges - 1 : 1;
+  if (nzedges == 0)
+    z_edges = NULL;
+
+  //Cast ells as integers
+  int *ell_int = malloc(nell * sizeof(int));
+  CCL_ClWorkspace *w = ccl_cl_workspace_default(
+        (int)(ell[nell - 1]) + 1,
+        (int)l_limber,
+        method,
+        l_logstep,
+        (int)l_linstep,
+        dchi,
+        dlk,
+        zmin,
+        status);
+  if (*status == 0) {
+    w->limber_method = limber_method;
+    w->l_epsrel = l_epsrel;
+  }
+
+  for(int i=0; i < nell; i++)
+    ell_int[i] = (int)(ell[i]);
+
+  //Compute C_ells
+  if (*status == 0)
+    ccl_angular_cls_bias_templates(cosmo, w, clt1, clt2, nzb, z_edges,
+                                   nell, ell_int, output, status);
+
+  free(ell_int);
+  if (w != NULL)
+    ccl_cl_workspace_free(w);
+}
+
+%}
+
+%feature("pythonprepend") angular_cl_bandpowers_vec %{
+    if numpy.shape(band_ptr) != (nout + 1,):
+        raise CCLError("Input shape for `band_ptr` must match `(nout + 1,)`!")
+
+    if numpy.shape(band_ell) != numpy.shape(band_w):
+        raise CCLError("Input shape for `band_ell` must match `band_w`!")
+%}
+
+%inline %{
+
+void angular_cl_bandpowers_vec(ccl_cosmology * cosmo, CCL_ClTracer *clt1, CCL_ClTracer *clt2,
+                               double l_limber, double l_logstep, double l_linstep,
+                               double dchi, double dlk, double zmin, int method,
+                               int limber_method, double l_epsrel,
+                               double* band_ptr, int nptr, double* band_ell, int nbell,
+                               double* band_w, int nbw, int nout, double* output, int *status) {
+  CCL_ClTracer *tracers[2] = {clt1, clt2};
+  int pair1 = 0, pair2 = 1;
+
+  //Cast row offsets and ells as integers
+  int *ptr_int = malloc(nptr * sizeof(int));
+  int *ell_int = malloc((nbell + 1) * sizeof(int));
+  int lmax = 1;
+  for(int i=0; i < nptr; i++)
+    ptr_int[i] = (int)(band_ptr[i]);
+  for(int i=0; i < nbell; i++) {
+    ell_int[i] = (int)(band_ell[i]);
+    if (ell_int[i] > lmax)
+      lmax = ell_int[i];
+  }
+
+  CCL_ClWorkspace *w = ccl_cl_workspace_default(
+        lmax + 1,
+        (int)l_limber,
+        method,
+        l_logstep,
+        (int)l_linstep,
+        dchi,
+        dlk,
+        zmin,
+        status);
+  if (*status == 0) {
+    w->limber_method = limber_method;
+    w->l_epsrel = l_epsrel;
+  }
+
+  //Compute bandpowers
+  if (*status == 0)
+    ccl_angular_cls_bandpowers(cosmo, w, 2, tracers, 1, &pair1, &pair2,
+                               nout, ptr_int, ell_int, band_w, output, status);
+
+  free(ptr_int);
+  free(ell_int);
+  if (w != NULL)
+    ccl_cl_workspace_free(w);
+}
+
+%}
+
 %feature("pythonprepend") clt_fa_vec %{
     if numpy.shape(aarr) != (nout,):
         raise CCLError("Input shape for `aarr` must match `(nout,)`!")
@@ -21,16 +21,12 @@
 %inline %{
 void linear_matter_power_vec(ccl_cosmology * cosmo, double a, double* k, int nk,
                              int nout, double* output, int* status) {
-    for(int i=0; i < nk; i++){
-      output[i] = ccl_linear_matter_power(cosmo, k[i], a, status);
-    }
+    ccl_linear_matter_powers_at_a(cosmo, a, nk, k, output, status);
 }
 
 void nonlin_matter_power_vec(ccl_cosmology * cosmo, double a, double* k, int nk,
                              int nout, double* output, int* status) {
-    for(int i=0; i < nk; i++){
-      output[i] = ccl_nonlin_matter_power(cosmo, k[i], a, status);
-    }
+    ccl_nonlin_matter_powers_at_a(cosmo, a, nk, k, output, status);
 }
 
 %}
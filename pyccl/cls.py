@@ -9,6 +9,14 @@ import collections
 nonlimber_methods = {
     'native': const.CCL_NONLIMBER_METHOD_NATIVE,
     'angpow': const.CCL_NONLIMBER_METHOD_ANGPOW,
+    'fftlog': const.CCL_NONLIMBER_METHOD_FFTLOG,
+    'levin': const.CCL_NONLIMBER_METHOD_LEVIN,
+}
+
+# Same mapping for Limber integration methods
+limber_methods = {
+    'qag': const.CCL_LIMBER_METHOD_QAG,
+    'grid': const.CCL_LIMBER_METHOD_GRID,
 }
 
 function_types = {
@@ -140,6 +148,48 @@ class Tracer(object):
             self.has_cltracer = True
             self.cltracer, status = return_val
 
+    def rebind(self, cosmo):
+        """Recompute the cosmology-dependent parts of this tracer.
+
+        The redshift-dependent inputs (N(z), bias, magnification bias and
+        intrinsic alignments) are kept, and only the distance limits and
+        lensing/magnification windows are recomputed for the new cosmology.
+        This is much cheaper than building a new tracer, e.g. when sampling
+        over cosmological parameters.
+
+        Args:
+            cosmo (:obj:`Cosmology`): Cosmology object to bind the tracer to.
+        """
+        cosmo_in = cosmo
+        cosmo = cosmo.cosmo
+        status = 0
+        status = lib.cl_tracer_rebind(cosmo, self.cltracer, status)
+        check(status, cosmo_in)
+
+    def set_photoz(self, cosmo, shift=0., stretch=1.):
+        """Set the photo-z shift and stretch of the redshift distribution.
+
+        The redshift distribution used by the tracer becomes
+        N(<z> + (z - <z> - shift) / stretch) / stretch, where N(z) is the
+        distribution passed at construction and <z> is its mean. Only the
+        quantities that depend on it are recomputed, so this is much cheaper
+        than building a new tracer.
+
+        Args:
+            cosmo (:obj:`Cosmology`): Cosmology object.
+            shift (float, optional): Shift in the mean redshift. Defaults
+                to 0.
+            stretch (float, optional): Stretch factor of the width of N(z)
+                around its mean. Must be positive. Defaults to 1.
+        """
+        cosmo_in = cosmo
+        cosmo = cosmo.cosmo
+        status = 0
+        status = lib.cl_tracer_set_photoz(cosmo, self.cltracer,
+                                          float(shift), float(stretch),
+                                          status)
+        check(status, cosmo_in)
+
     def get_internal_function(self, cosmo, function, a):
         """
         Method to evaluate any internal function of redshift for this tracer.
@@ -293,7 +343,8 @@ def _check_array_params(f_arg):
 
 def angular_cl(cosmo, cltracer1, cltracer2, ell,
                l_limber=-1., l_logstep=1.05, l_linstep=20., dchi=3.,
-               dlk=0.003, zmin=0.05, non_limber_method="native"):
+               dlk=0.003, zmin=0.05, non_limber_method="native",
+               limber_method="qag", l_epsrel=0.):
     """Calculate the angular (cross-)power spectrum for a pair of tracers.
 
     Args:
@@ -313,7 +364,28 @@ def angular_cl(cosmo, cltracer1, cltracer2, ell,
             Defaults to 0.003.
         zmin (float) : minimal redshift for the integrals. Defualts to 0.05.
         non_limber_method (str) : non-Limber integration method. Supported:
-            "native" and "angpow". Defaults to 'native'.
+            "native", "angpow", "fftlog" (spherical Bessel transforms of
+            the radial kernels, much faster for narrow redshift bins) and
+            "levin" (adaptive integration over comoving distance, with the
+            accuracy set by the Limber integration tolerance). "angpow"
+            only handles the density and RSD terms of number counts
+            tracers, and uses "levin" for anything involving lensing or
+            magnification (or "native" for everything if CCL was built
+            without Angpow). CMB lensing only goes beyond Limber's
+            approximation with "levin". With a nonlinear power spectrum,
+            "fftlog" is only meant for narrow kernels; use "levin" or
+            "native" for lensing and magnification.
+            Defaults to 'native'.
+        limber_method (str) : Limber integration method. Supported: "qag"
+            (adaptive integration for each multipole) and "grid" (sums over
+            a grid in comoving distance shared by all multipoles, much faster
+            at high ell). Tracers with RSD always use "qag".
+            Defaults to 'qag'.
+        l_epsrel (float) : if positive, the power spectrum is only computed
+            at the subset of the multipoles sampled by l_logstep and
+            l_linstep needed to interpolate it with this relative accuracy,
+            chosen by bisection in log(ell). If 0, all of them are used.
+            Defaults to 0.
 
     Returns:
         float or array_like: Angular (cross-)power spectrum values,
@@ -328,6 +400,10 @@ def angular_cl(cosmo, cltracer1, cltracer2, ell,
             "'%s' is not a valid non-Limber integration method." %
             non_limber_method)
 
+    if limber_method not in limber_methods.keys():
+        raise ValueError(
+            "'%s' is not a valid Limber integration method." % limber_method)
+
     # Access CCL_ClTracer objects
     clt1 = cltracer1.cltracer
     clt2 = cltracer2.cltracer
@@ -338,17 +414,249 @@ def angular_cl(cosmo, cltracer1, cltracer2, ell,
         # Use single-value function
         cl_one, status = lib.angular_cl_vec(
             cosmo, clt1, clt2, l_limber, l_logstep, l_linstep, dchi, dlk, zmin,
-            nonlimber_methods[non_limber_method], [ell], 1, status)
+            nonlimber_methods[non_limber_method],
+            limber_methods[limber_method], l_epsrel, [ell], 1, status)
         cl = cl_one[0]
     elif isinstance(ell, np.ndarray):
         # Use vectorised function
         cl, status = lib.angular_cl_vec(
             cosmo, clt1, clt2, l_limber, l_logstep, l_linstep, dchi, dlk, zmin,
-            nonlimber_methods[non_limber_method], ell, ell.size, status)
+            nonlimber_methods[non_limber_method],
+            limber_methods[limber_method], l_epsrel, ell, ell.size, status)
     else:
         # Use vectorised function
         cl, status = lib.angular_cl_vec(
             cosmo, clt1, clt2, l_limber, l_logstep, l_linstep, dchi, dlk, zmin,
-            nonlimber_methods[non_limber_method], ell, len(ell), status)
+            nonlimber_methods[non_limber_method],
+            limber_methods[limber_method], l_epsrel, ell, len(ell), status)
+    check(status)
+    return cl
+
+
+def angular_cl_matrix(cosmo, tracers, ell,
+                      l_limber=-1., l_logstep=1.05, l_linstep=20., dchi=3.,
+                      dlk=0.003, zmin=0.05, non_limber_method="native",
+                      limber_method="grid", l_epsrel=0.):
+    """Calculate the angular power spectra of all pairs of a set of tracers.
+
+    With the "grid" Limber method, the background quantities and the power
+    spectrum are evaluated once and shared by all pairs, which is much faster
+    than calling :func:`angular_cl` for each pair.
+
+    Args:
+        cosmo (:obj:`Cosmology`): A Cosmology object.
+        tracers (list of :obj:`Tracer`): Tracer objects, of any kind.
+        ell (float or array_like): Angular wavenumber(s) at which to evaluate
+            the angular power spectra.
+        l_limber, l_logstep, l_linstep, dchi, dlk, zmin, non_limber_method,
+        l_epsrel: see :func:`angular_cl`.
+        limber_method (str) : Limber integration method. Supported: "qag"
+            and "grid" (see :func:`angular_cl`). Defaults to 'grid', unlike
+            :func:`angular_cl`, since only the grid method shares the power
+            spectrum between pairs. Pass 'qag' to reproduce the default
+            :func:`angular_cl` spectra.
+
+    Returns:
+        array_like: Angular power spectra, :math:`C_\\ell`, with shape
+            `(len(tracers), len(tracers))` for a single `ell` or
+            `(len(tracers), len(tracers), len(ell))` otherwise.
+    """
+    # Access ccl_cosmology object
+    cosmo = cosmo.cosmo
+
+    if non_limber_method not in nonlimber_methods.keys():
+        raise ValueError(
+            "'%s' is not a valid non-Limber integration method." %
+            non_limber_method)
+
+    if limber_method not in limber_methods.keys():
+        raise ValueError(
+            "'%s' is not a valid Limber integration method." % limber_method)
+
+    # Access CCL_ClTracer objects
+    clts = [t.cltracer for t in tracers]
+    ntr = len(clts)
+    npairs = ntr * (ntr + 1) // 2
+
+    scalar = isinstance(ell, float) or isinstance(ell, int)
+    ell_use = np.atleast_1d(np.array(ell, dtype=float))
+    nell = ell_use.size
+
+    status = 0
+    cl_pairs, status = lib.angular_cl_matrix_vec(
+        cosmo, clts, l_limber, l_logstep, l_linstep, dchi, dlk, zmin,
+        nonlimber_methods[non_limber_method],
+        limber_methods[limber_method], l_epsrel, ell_use, npairs * nell,
+        status)
     check(status)
+
+    # Unpack the pairs into a symmetric matrix
+    cl_pairs = cl_pairs.reshape([npairs, nell])
+    cl = np.zeros([ntr, ntr, nell])
+    i1, i2 = np.triu_indices(ntr)
+    cl[i1, i2] = cl_pairs
+    cl[i2, i1] = cl_pairs
+    if scalar:
+        cl = cl[:, :, 0]
     return cl
+
+
+def angular_cl_bias_templates(cosmo, cltracer1, cltracer2, ell, z_edges=None,
+                              l_limber=-1., l_logstep=1.05, l_linstep=20.,
+                              dchi=3., dlk=0.003, zmin=0.05,
+                              non_limber_method="native",
+                              limber_method="grid", l_epsrel=0.):
+    """Calculate the angular power spectra between the bias templates of two
+    tracers.
+
+    The transfer function of a :obj:`NumberCountsTracer` with a galaxy bias
+    that is piecewise constant in redshift bins is a linear combination of
+    templates: the density term with unit bias in each bin, followed by the
+    RSD and magnification terms (if the tracer has them). The coefficients
+    are the bias in each bin, followed by ones. Any other tracer is its own
+    single template, with coefficient one. The angular power spectrum for
+    any values of the bias is then
+
+    .. math::
+        C_\\ell = \\sum_{ij} c^1_i c^2_j C^{ij}_\\ell,
+
+    which can be evaluated without recomputing any integral. The bias b(z)
+    that the tracers were built with is ignored.
+
+    Args:
+        cosmo (:obj:`Cosmology`): A Cosmology object.
+        cltracer1, cltracer2 (:obj:`Tracer`): Tracer objects, of any kind.
+        ell (float or array_like): Angular wavenumber(s) at which to evaluate
+            the angular power spectra.
+        z_edges (array_like, optional): Edges of the redshift bins of the
+            galaxy bias. If `None`, the bias is assumed to be constant and a
+            single density template is returned. Defaults to None.
+        l_limber, l_logstep, l_linstep, dchi, dlk, zmin, non_limber_method,
+        l_epsrel: see :func:`angular_cl`.
+        limber_method (str) : Limber integration method. Supported: "qag"
+            and "grid" (see :func:`angular_cl`). Defaults to 'grid', unlike
+            :func:`angular_cl`, since the templates are evaluated together
+            and the grid method shares the power spectrum between them.
+
+    Returns:
+        array_like: Angular power spectra of the templates, with shape
+            `(n1, n2)` for a single `ell` or `(n1, n2, len(ell))` otherwise,
+            where `n1` and `n2` are the numbers of templates of each tracer.
+    """
+    # Access ccl_cosmology object
+    cosmo = cosmo.cosmo
+
+    if non_limber_method not in nonlimber_methods.keys():
+        raise ValueError(
+            "'%s' is not a valid non-Limber integration method." %
+            non_limber_method)
+
+    if limber_method not in limber_methods.keys():
+        raise ValueError(
+            "'%s' is not a valid Limber integration method." % limber_method)
+
+    if z_edges is None:
+        z_edges = NoneArr
+    z_edges = np.atleast_1d(np.array(z_edges, dtype=float))
+    nzb = max(z_edges.size - 1, 1)
+
+    # Access CCL_ClTracer objects
+    clt1 = cltracer1.cltracer
+    clt2 = cltracer2.cltracer
+    n1 = lib.cl_tracer_n_bias_templates(clt1, nzb)
+    n2 = lib.cl_tracer_n_bias_templates(clt2, nzb)
+
+    scalar = isinstance(ell, float) or isinstance(ell, int)
+    ell_use = np.atleast_1d(np.array(ell, dtype=float))
+    nell = ell_use.size
+
+    status = 0
+    cl, status = lib.angular_cl_bias_templates_vec(
+        cosmo, clt1, clt2, z_edges, l_limber, l_logstep, l_linstep, dchi,
+        dlk, zmin, nonlimber_methods[non_limber_method],
+        limber_methods[limber_method], l_epsrel, ell_use, n1 * n2 * nell,
+        status)
+    check(status)
+
+    cl = cl.reshape([n1, n2, nell])
+    if scalar:
+        cl = cl[:, :, 0]
+    return cl
+
+
+def angular_cl_bandpowers(cosmo, cltracer1, cltracer2, windows, ell=None,
+                          l_limber=-1., l_logstep=1.05, l_linstep=20.,
+                          dchi=3., dlk=0.003, zmin=0.05,
+                          non_limber_method="native",
+                          limber_method="qag", l_epsrel=0.):
+    """Calculate the bandpowers of the angular (cross-)power spectrum of a
+    pair of tracers,
+
+    .. math::
+        C_b = \\sum_\\ell W_{b\\ell} C_\\ell.
+
+    The power spectrum is interpolated once into all the multipoles in the
+    windows, and the windows are applied as a sparse matrix, so that only
+    their non-zero entries are evaluated.
+
+    Args:
+        cosmo (:obj:`Cosmology`): A Cosmology object.
+        cltracer1, cltracer2 (:obj:`Tracer`): Tracer objects, of any kind.
+        windows (array_like or sparse matrix): Bandpower windows, with shape
+            `(n_bands, n_ell)`. Any object with a `tocsr` method (e.g. a
+            `scipy.sparse` matrix) is used in sparse form.
+        ell (array_like, optional): Multipoles of the columns of `windows`.
+            If `None`, column `i` corresponds to :math:`\\ell=i`.
+            Defaults to None.
+        l_limber, l_logstep, l_linstep, dchi, dlk, zmin, non_limber_method,
+        limber_method, l_epsrel: see :func:`angular_cl`.
+
+    Returns:
+        array_like: Bandpowers, :math:`C_b`, with shape `(n_bands,)`.
+    """
+    # Access ccl_cosmology object
+    cosmo = cosmo.cosmo
+
+    if non_limber_method not in nonlimber_methods.keys():
+        raise ValueError(
+            "'%s' is not a valid non-Limber integration method." %
+            non_limber_method)
+
+    if limber_method not in limber_methods.keys():
+        raise ValueError(
+            "'%s' is not a valid Limber integration method." % limber_method)
+
+    # Windows in CSR format
+    if hasattr(windows, 'tocsr'):
+        windows = windows.tocsr()
+        nb, ncol = windows.shape
+        band_ptr = np.array(windows.indptr, dtype=float)
+        cols = np.array(windows.indices)
+        band_w = np.array(windows.data, dtype=float)
+    else:
+        windows = np.atleast_2d(np.array(windows, dtype=float))
+        nb, ncol = windows.shape
+        rows, cols = np.nonzero(windows)
+        band_ptr = np.zeros(nb + 1)
+        band_ptr[1:] = np.cumsum(np.bincount(rows, minlength=nb))
+        band_w = windows[rows, cols]
+
+    if ell is None:
+        ell = np.arange(ncol)
+    ell = np.atleast_1d(np.array(ell, dtype=float))
+    if ell.shape != (ncol,):
+        raise ValueError("`ell` must have one entry per column of `windows`")
+    band_ell = ell[cols]
+
+    # Access CCL_ClTracer objects
+    clt1 = cltracer1.cltracer
+    clt2 = cltracer2.cltracer
+
+    status = 0
+    cb, status = lib.angular_cl_bandpowers_vec(
+        cosmo, clt1, clt2, l_limber, l_logstep, l_linstep, dchi, dlk, zmin,
+        nonlimber_methods[non_limber_method],
+        limber_methods[limber_method], l_epsrel, band_ptr, band_ell, band_w,
+        nb, status)
+    check(status)
+    return cb
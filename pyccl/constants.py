@@ -4,7 +4,9 @@ from .ccllib import (
     CCL_ERROR_CLASS, CCL_ERROR_INCONSISTENT, CCL_ERROR_INTEG,
     CCL_ERROR_LINSPACE, CCL_ERROR_MEMORY, CCL_ERROR_ROOT, CCL_ERROR_SPLINE,
     CCL_ERROR_SPLINE_EV, CLIGHT_HMPC, CL_TRACER_NC, CL_TRACER_WL, CL_TRACER_CL,
-    CCL_NONLIMBER_METHOD_NATIVE, CCL_NONLIMBER_METHOD_ANGPOW, CCL_CLT_NZ,
+    CCL_NONLIMBER_METHOD_NATIVE, CCL_NONLIMBER_METHOD_ANGPOW,
+    CCL_NONLIMBER_METHOD_FFTLOG, CCL_NONLIMBER_METHOD_LEVIN,
+    CCL_LIMBER_METHOD_QAG, CCL_LIMBER_METHOD_GRID, CCL_CLT_NZ,
     CCL_CLT_BZ, CCL_CLT_SZ, CCL_CLT_WM, CCL_CLT_RF, CCL_CLT_BA, CCL_CLT_WL,
     DNDZ_NC, DNDZ_WL_CONS, DNDZ_WL_FID, DNDZ_WL_OPT, EPS_SCALEFAC_GROWTH,
     GNEWT, K_PIVOT, MPC_TO_METER, PC_TO_METER, RHO_CRITICAL, SOLAR_MASS,
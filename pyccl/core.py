@@ -146,6 +146,7 @@ error_types = {
     lib.CCL_ERROR_PARAMETERS:          'CCL_ERROR_PARAMETERS',
     lib.CCL_ERROR_NU_INT:	           'CCL_ERROR_NU_INT',
     lib.CCL_ERROR_EMULATOR_BOUND:      'CCL_ERROR_EMULATOR_BOUND',
+    lib.CCL_ERROR_EMULATOR:            'CCL_ERROR_EMULATOR',
     lib.CCL_ERROR_MISSING_CONFIG_FILE: 'CCL_ERROR_MISSING_CONFIG_FILE',
 }
 
@@ -222,6 +223,11 @@ class Cosmology(object):
             mnu_type = 'sum_equal', and 'equalize', which will redistribute
             masses to be equal right before calling the emualtor but results in
             internal inconsistencies. Defaults to 'strict'.
+        n_threads (:obj:`int`, optional): Number of OpenMP threads used to
+            compute the power spectrum tables and the angular power spectra.
+            Defaults to 0, which uses the
+            OpenMP default (e.g. set by the OMP_NUM_THREADS environment
+            variable). The results do not depend on this number.
     """
     def __init__(
             self, Omega_c=None, Omega_b=None, h=None, n_s=None,
@@ -234,7 +240,8 @@ class Cosmology(object):
             baryons_power_spectrum='nobaryons',
             mass_function='tinker10',
             halo_concentration='duffy2008',
-            emulator_neutrinos='strict'):
+            emulator_neutrinos='strict',
+            n_threads=0):
 
         # going to save these for later
         self._params_init_kwargs = dict(
@@ -249,7 +256,8 @@ class Cosmology(object):
             baryons_power_spectrum=baryons_power_spectrum,
             mass_function=mass_function,
             halo_concentration=halo_concentration,
-            emulator_neutrinos=emulator_neutrinos)
+            emulator_neutrinos=emulator_neutrinos,
+            n_threads=n_threads)
 
         self._build_cosmo()
 
@@ -321,14 +329,15 @@ class Cosmology(object):
             self, transfer_function=None, matter_power_spectrum=None,
             baryons_power_spectrum=None,
             mass_function=None, halo_concentration=None,
-            emulator_neutrinos=None):
+            emulator_neutrinos=None, n_threads=0):
         """Build a ccl_configuration struct.
 
         This function builds C ccl_configuration struct. This structure
         controls which various approximations are used for the transfer
         function, matter power spectrum, baryonic effect in the matter
-        power spectrum, mass function, halo concentration relation, and
-        neutrino effects in the emulator.
+        power spectrum, mass function, halo concentration relation,
+        neutrino effects in the emulator, and the number of threads used
+        in parallel computations.
 
         It also does some error checking on the inputs to make sure they
         are valid and physically consistent.
@@ -380,6 +389,9 @@ class Cosmology(object):
                              "with transfer_function '%s'."
                              % (matter_power_spectrum, transfer_function))
 
+        if n_threads < 0:
+            raise ValueError("n_threads must be non-negative.")
+
         # Assign values to new ccl_configuration object
         config = lib.configuration()
 
@@ -395,6 +407,7 @@ class Cosmology(object):
             halo_concentration_types[halo_concentration]
         config.emulator_neutrinos_method = \
             emulator_neutrinos_types[emulator_neutrinos]
+        config.n_threads = int(n_threads)
 
         # Store ccl_configuration for later access
         self._config = config
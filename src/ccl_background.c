@@ -24,7 +24,7 @@ static double h_over_h0(double a, ccl_cosmology * cosmo, int *status)
   if ((cosmo->params.N_nu_mass)>1e-12) {
     Om_mass_nu = ccl_Omeganuh2(
       a, cosmo->params.N_nu_mass, cosmo->params.mnu, cosmo->params.T_CMB,
-      cosmo->data.accelerator, status) / (cosmo->params.h) / (cosmo->params.h);
+      NULL, status) / (cosmo->params.h) / (cosmo->params.h);
     ccl_check_status(cosmo, status);
   }
   else {
@@ -68,7 +68,7 @@ double ccl_omega_x(ccl_cosmology * cosmo, double a, ccl_species_x_label label, i
   if ((cosmo->params.N_nu_mass) > 0.0001) {
     // Call the massive neutrino density function just once at this redshift.
     OmNuh2 = ccl_Omeganuh2(a, cosmo->params.N_nu_mass, cosmo->params.mnu,
-		       cosmo->params.T_CMB, cosmo->data.accelerator, status);
+		       cosmo->params.T_CMB, NULL, status);
     ccl_check_status(cosmo, status);
   }
   else {
@@ -184,158 +184,183 @@ static double df_integrand(double a,void * spline_void)
 }
 
 /* --------- ROUTINE: growth_factor_and_growth_rate ---------
-INPUT: scale factor, cosmology
-TASK: compute the growth (D(z)) and the growth rate, logarithmic derivative (f?)
+INPUT: number of nodes, scale factor nodes (ascending), cosmology
+OUTPUT: growth (D(a)) and growth rate (f(a)) at each node, and at a=1
+TASK: integrate the growth ODE once from EPS_SCALEFAC_GROWTH to a=1, recording
+      D and f as the integration passes through each node. The same driver is
+      applied to successive nodes so that its step-size control carries over
+      from one interval to the next; the total cost is that of a single
+      integration instead of one integration per node.
 */
 
-static int  growth_factor_and_growth_rate(double a,double *gf,double *fg,ccl_cosmology *cosmo, int *stat)
+static int growth_factor_and_growth_rate(int na,double *a,double *gf,double *fg,
+					 double *gf1,double *fg1,
+					 ccl_cosmology *cosmo,int *stat)
 {
-  if(a<EPS_SCALEFAC_GROWTH) {
-    *gf=a;
-    *fg=1;
-    return 0;
-  }
-  else {
-    int gslstatus;
-    double y[2];
-    double ainit=EPS_SCALEFAC_GROWTH;
-    gsl_odeiv2_system sys={growth_ode_system,NULL,2,cosmo};
-    gsl_odeiv2_driver *d=
-      gsl_odeiv2_driver_alloc_y_new(&sys,gsl_odeiv2_step_rkck,0.1*EPS_SCALEFAC_GROWTH,0,ccl_gsl->ODE_GROWTH_EPSREL);
-
-    y[0]=EPS_SCALEFAC_GROWTH;
-    y[1]=EPS_SCALEFAC_GROWTH*EPS_SCALEFAC_GROWTH*EPS_SCALEFAC_GROWTH*
-      h_over_h0(EPS_SCALEFAC_GROWTH,cosmo, stat);
-
-    gslstatus=gsl_odeiv2_driver_apply(d,&ainit,a,y);
-    gsl_odeiv2_driver_free(d);
+  int gslstatus=GSL_SUCCESS;
+  double y[2];
+  double ainit=EPS_SCALEFAC_GROWTH;
+  gsl_odeiv2_system sys={growth_ode_system,NULL,2,cosmo};
+  gsl_odeiv2_driver *d=
+    gsl_odeiv2_driver_alloc_y_new(&sys,gsl_odeiv2_step_rkck,0.1*EPS_SCALEFAC_GROWTH,0,ccl_gsl->ODE_GROWTH_EPSREL);
+
+  y[0]=EPS_SCALEFAC_GROWTH;
+  y[1]=EPS_SCALEFAC_GROWTH*EPS_SCALEFAC_GROWTH*EPS_SCALEFAC_GROWTH*
+    h_over_h0(EPS_SCALEFAC_GROWTH,cosmo, stat);
+
+  for(int i=0;i<=na;i++) {
+    //The last pass takes us to a=1, used for normalization
+    double a_here=(i<na) ? a[i] : 1.;
+    double *gf_here=(i<na) ? &(gf[i]) : gf1;
+    double *fg_here=(i<na) ? &(fg[i]) : fg1;
+
+    if(a_here<EPS_SCALEFAC_GROWTH) {
+      *gf_here=a_here;
+      *fg_here=1;
+      continue;
+    }
 
+    //Nodes coinciding with the current position need no further steps
+    if(a_here>ainit)
+      gslstatus=gsl_odeiv2_driver_apply(d,&ainit,a_here,y);
     if(gslstatus != GSL_SUCCESS) {
       ccl_raise_gsl_warning(gslstatus, "ccl_background.c: growth_factor_and_growth_rate():");
-      return NAN;
+      //Zero the nodes the integration did not reach so that no output is left unset
+      for(int j=i;j<na;j++) {
+        gf[j]=0;
+        fg[j]=0;
+      }
+      *gf1=0;
+      *fg1=0;
+      break;
     }
 
-    *gf=y[0];
-    *fg=y[1]/(a*a*h_over_h0(a,cosmo, stat)*y[0]);
-    return 0;
+    *gf_here=y[0];
+    *fg_here=y[1]/(a_here*a_here*h_over_h0(a_here,cosmo, stat)*y[0]);
   }
+  gsl_odeiv2_driver_free(d);
+
+  return gslstatus;
 }
 
 
-/* --------- ROUTINE: compute_chi ---------
-INPUT: scale factor, cosmology
-OUTPUT: chi -> radial comoving distance
-TASK: compute radial comoving distance at a
+/* --------- ROUTINE: chi_panel ---------
+INPUT: panel limits, integrand, Gauss-Legendre table, estimate of the panel integral
+OUTPUT: integral of chi_integrand over the panel
+TASK: integrate over a single panel of the scale factor grid, bisecting it until the
+      Gauss-Legendre estimates on the panel and on its two halves agree to
+      INTEGRATION_DISTANCE_EPSREL.
 */
-static void compute_chi(double a, ccl_cosmology *cosmo, double * chi, int * stat)
+static int chi_panel(double a0,double a1,gsl_function *F,gsl_integration_glfixed_table *t,
+		     double whole,int depth,double *result)
 {
-  int gslstatus;
-  double result;
+  double am=0.5*(a0+a1);
+  double left=gsl_integration_glfixed(F,a0,am,t);
+  double right=gsl_integration_glfixed(F,am,a1,t);
+
+  if(fabs(left+right-whole)<=ccl_gsl->INTEGRATION_DISTANCE_EPSREL*fabs(left+right)) {
+    *result=left+right;
+    return GSL_SUCCESS;
+  }
+  if(depth>=CHI_GL_MAX_DEPTH) {
+    *result=left+right;
+    return GSL_EMAXITER;
+  }
+
+  int gslstatus=chi_panel(a0,am,F,t,left,depth+1,&left);
+  gslstatus|=chi_panel(am,a1,F,t,right,depth+1,&right);
+  *result=left+right;
+  return gslstatus;
+}
+
+/* --------- ROUTINE: compute_chi_cumulative ---------
+INPUT: number of nodes, scale factor nodes (ascending), cosmology
+OUTPUT: chi -> radial comoving distance at each node
+TASK: compute the radial comoving distance at all nodes in a single pass. The
+      integral is split into panels between consecutive nodes and accumulated
+      from a=1 downwards, so that each panel is only integrated once.
+*/
+static void compute_chi_cumulative(int na, double *a, ccl_cosmology *cosmo, double *chi, int *stat)
+{
+  int gslstatus=GSL_SUCCESS;
+  double sum=0,panel;
   chipar p;
 
   p.cosmo=cosmo;
   p.status=stat;
 
-  gsl_integration_cquad_workspace * workspace = gsl_integration_cquad_workspace_alloc(ccl_gsl->N_ITERATION);
+  gsl_integration_glfixed_table *t=gsl_integration_glfixed_table_alloc(CHI_GL_ORDER);
+  if(t==NULL) {
+    *stat=CCL_ERROR_MEMORY;
+    return;
+  }
   gsl_function F;
   F.function = &chi_integrand;
   F.params = &p;
-  //TODO: CQUAD is great, but slower than other methods. This could be sped up if it becomes an issue.
-  gslstatus=gsl_integration_cquad(
-    &F, a, 1.0, 0.0, ccl_gsl->INTEGRATION_DISTANCE_EPSREL, workspace, &result, NULL, NULL);
-  *chi=result/cosmo->params.h;
-  gsl_integration_cquad_workspace_free(workspace);
+
+  //Panel between the last node and a=1 (empty if A_SPLINE_MAX=1)
+  if(a[na-1]<1.) {
+    gslstatus|=chi_panel(a[na-1],1.,&F,t,gsl_integration_glfixed(&F,a[na-1],1.,t),0,&panel);
+    sum+=panel;
+  }
+  chi[na-1]=sum/cosmo->params.h;
+  for(int i=na-2;i>=0;i--) {
+    gslstatus|=chi_panel(a[i],a[i+1],&F,t,gsl_integration_glfixed(&F,a[i],a[i+1],t),0,&panel);
+    sum+=panel;
+    chi[i]=sum/cosmo->params.h;
+  }
+  gsl_integration_glfixed_table_free(t);
 
   if (gslstatus != GSL_SUCCESS) {
-    ccl_raise_gsl_warning(gslstatus, "ccl_background.c: compute_chi():");
+    ccl_raise_gsl_warning(gslstatus, "ccl_background.c: compute_chi_cumulative():");
     *stat = CCL_ERROR_COMPUTECHI;
   }
 }
 
 
-//Root finding for a(chi)
-typedef struct {
-  double chi;
-  ccl_cosmology *cosmo;
-  int * status;
-} Fpar;
-
-static double fzero(double a,void *params)
-{
-  double chi,chia,a_use=a;
-
-  chi=((Fpar *)params)->chi;
-  compute_chi(a_use,((Fpar *)params)->cosmo,&chia, ((Fpar *)params)->status);
-
-  return chi-chia;
-}
-
-static double dfzero(double a,void *params)
-{
-  ccl_cosmology *cosmo=((Fpar *)params)->cosmo;
-  int *stat = ((Fpar *)params)->status;
-
-  chipar p;
-  p.cosmo=cosmo;
-  p.status=stat;
-
-  return chi_integrand(a,&p)/cosmo->params.h;
-}
-
-static void fdfzero(double a,void *params,double *f,double *df)
-{
-  *f=fzero(a,params);
-  *df=dfzero(a,params);
-}
-
 /* --------- ROUTINE: a_of_chi ---------
-INPUT: comoving distance chi, cosmology, stat, a_old, gsl_root_fdfsolver
+INPUT: comoving distance chi, chi(a) spline, scale factor nodes and their distances, bracket index
 OUTPUT: scale factor
-TASK: compute the scale factor that corresponds to a given comoving distance chi
-Note: This routine uses a root solver to find an a such that compute_chi(a) = chi.
-The root solver uses the derivative of compute_chi (which is chi_integrand) and
-the value itself.
+TASK: compute the scale factor that corresponds to a given comoving distance chi by
+      inverting the chi(a) table. The node interval containing chi is located by
+      walking from the previous bracket (distances are requested in ascending order),
+      and the root is then polished with Newton iterations on the chi(a) spline itself.
+      No integrals are evaluated here.
 */
-static void a_of_chi(double chi, ccl_cosmology *cosmo, int* stat, double *a_old, gsl_root_fdfsolver *s)
+static int a_of_chi(double chi, gsl_spline *chi_spline, int na, double *a, double *chi_a,
+		    int *ibracket, double *a_out)
 {
-  if(chi==0) {
-    *a_old=1;
-  }
-  else {
-    Fpar p;
-    gsl_function_fdf FDF;
-    double a_previous,a_current=*a_old;
-
-    p.cosmo=cosmo;
-    p.chi=chi;
-    p.status=stat;
-    FDF.f=&fzero;
-    FDF.df=&dfzero;
-    FDF.fdf=&fdfzero;
-    FDF.params=&p;
-    gsl_root_fdfsolver_set(s,&FDF,a_current);
-
-    int iter=0, gslstatus;
-    do {
-      iter++;
-      gslstatus=gsl_root_fdfsolver_iterate(s);
-      if(gslstatus!=GSL_SUCCESS) ccl_raise_gsl_warning(gslstatus, "ccl_background.c: a_of_chi():");
-      a_previous=a_current;
-      a_current=gsl_root_fdfsolver_root(s);
-      gslstatus=gsl_root_test_delta(a_current, a_previous, 0, ccl_gsl->ROOT_EPSREL);
-    } while(gslstatus==GSL_CONTINUE && iter <= ccl_gsl->ROOT_N_ITERATION);
-
-    *a_old=a_current;
-
-    // Allows us to pass a status to h_over_h0 for the neutrino integral calculation.
-    if(gslstatus==GSL_SUCCESS) {
-      *stat = *(p.status);
-    }
-    else {
-      ccl_raise_gsl_warning(gslstatus, "ccl_background.c: a_of_chi():");
-      *stat = CCL_ERROR_COMPUTECHI;
-    }
-  }
+  //chi_a is decreasing with a. Find i such that chi_a[i+1] <= chi <= chi_a[i]
+  int i=*ibracket;
+  while(i>0 && chi_a[i]<chi)
+    i--;
+  *ibracket=i;
+
+  double alo=a[i],ahi=a[i+1];
+  double a_current,a_previous;
+  if(chi_a[i]==chi_a[i+1])
+    a_current=ahi;
+  else
+    a_current=alo+(ahi-alo)*(chi_a[i]-chi)/(chi_a[i]-chi_a[i+1]);
+
+  int iter=0, gslstatus;
+  do {
+    double c,dc;
+    iter++;
+    gslstatus=gsl_spline_eval_e(chi_spline,a_current,NULL,&c);
+    gslstatus|=gsl_spline_eval_deriv_e(chi_spline,a_current,NULL,&dc);
+    if(gslstatus!=GSL_SUCCESS || dc==0)
+      break;
+    a_previous=a_current;
+    a_current-=(c-chi)/dc;
+    //Stay within the bracketing interval
+    if(a_current<alo) a_current=alo;
+    if(a_current>ahi) a_current=ahi;
+    gslstatus=gsl_root_test_delta(a_current, a_previous, 0, ccl_gsl->ROOT_EPSREL);
+  } while(gslstatus==GSL_CONTINUE && iter <= ccl_gsl->ROOT_N_ITERATION);
+
+  *a_out=a_current;
+  return gslstatus;
 }
 
 /* ----- ROUTINE: ccl_cosmology_compute_distances ------
@@ -399,9 +424,8 @@ void ccl_cosmology_compute_distances(ccl_cosmology * cosmo, int *status)
     return;
   }
 
-  for (int i=0; i<na; i++) {
-    compute_chi(a[i],cosmo,&(y[i]), status);
-   }
+  // Fill in chi(a), accumulating the integral over the same grid
+  compute_chi_cumulative(na,a,cosmo,y,status);
 
   if (*status) {
     free(a);
@@ -425,15 +449,16 @@ void ccl_cosmology_compute_distances(ccl_cosmology * cosmo, int *status)
     return;
   }
 
-  //Spline for a(chi)
-  double dchi=5.,chi0=y[na-1],chif=y[0],a0=a[na-1],af=a[0];
-  //TODO: The interval in chi (5. Mpc) should be made a macro
-  free(y); free(a);
-  na=(int)((chif-chi0)/dchi);
-  y=ccl_linear_spacing(chi0,chif,na);
-  dchi=(chif-chi0)/na;
+  //Spline for a(chi), obtained by inverting the chi(a) table
+  double *a_nodes=a,*chi_nodes=y;
+  int na_nodes=na;
+  double chi0=y[na-1],chif=y[0],a0=a[na-1],af=a[0];
+  na=(ccl_splines->CHI_SPLINE_DELTA>0) ? (int)((chif-chi0)/ccl_splines->CHI_SPLINE_DELTA) : 0;
+  y=(na>1) ? ccl_linear_spacing(chi0,chif,na) : NULL;
   if(y==NULL || (fabs(y[0]-chi0)>1E-5) || (fabs(y[na-1]-chif)>1e-5)) {
     free(y);
+    free(a_nodes);
+    free(chi_nodes);
     gsl_spline_free(E);
     gsl_spline_free(chi);
     *status = CCL_ERROR_LINSPACE;
@@ -444,6 +469,8 @@ void ccl_cosmology_compute_distances(ccl_cosmology * cosmo, int *status)
   a=malloc(sizeof(double)*na);
   if(a==NULL) {
     free(y);
+    free(a_nodes);
+    free(chi_nodes);
     gsl_spline_free(E);
     gsl_spline_free(chi);
     *status=CCL_ERROR_MEMORY;
@@ -452,23 +479,20 @@ void ccl_cosmology_compute_distances(ccl_cosmology * cosmo, int *status)
   }
 
   a[0]=a0; a[na-1]=af;
-  const gsl_root_fdfsolver_type *T=gsl_root_fdfsolver_newton;
-  gsl_root_fdfsolver *s=gsl_root_fdfsolver_alloc(T);
-  for(int i=1;i<na-1;i++) {
-    // we are using the previous value as a guess here to help the root finder
-    // as long as we use small steps in a this should be fine
-    a_of_chi(y[i],cosmo, status, &a0,s);
-    a[i]=a0;
-  }
-
-  gsl_root_fdfsolver_free(s);
-  if(*status) {
+  int ibracket=na_nodes-2, rootstatus=0;
+  for(int i=1;i<na-1;i++)
+    rootstatus|=a_of_chi(y[i],chi,na_nodes,a_nodes,chi_nodes,&ibracket,&(a[i]));
+  free(a_nodes);
+  free(chi_nodes);
+
+  if(rootstatus) {
+    ccl_raise_gsl_warning(rootstatus, "ccl_background.c: a_of_chi():");
     free(a);
     free(y);
     gsl_spline_free(E);
     gsl_spline_free(chi);
     *status = CCL_ERROR_ROOT;
-    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_cosmology_compute_distances(): a(chi) root-finding error \n");
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_cosmology_compute_distances(): a(chi) inversion error \n");
     return;
   }
 
@@ -486,11 +510,29 @@ void ccl_cosmology_compute_distances(ccl_cosmology * cosmo, int *status)
     return;
   }
 
-  if(cosmo->data.accelerator==NULL)
-    cosmo->data.accelerator=gsl_interp_accel_alloc();
+  ccl_table1d *tab_E=ccl_table1d_new(E);
+  ccl_table1d *tab_chi=ccl_table1d_new(chi);
+  ccl_table1d *tab_achi=ccl_table1d_new(achi);
+  if(tab_E==NULL || tab_chi==NULL || tab_achi==NULL) {
+    free(a);
+    free(y);
+    gsl_spline_free(E);
+    gsl_spline_free(chi);
+    gsl_spline_free(achi);
+    ccl_table1d_free(tab_E);
+    ccl_table1d_free(tab_chi);
+    ccl_table1d_free(tab_achi);
+    *status = CCL_ERROR_SPLINE;
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_cosmology_compute_distances(): Error creating distance tables\n");
+    return;
+  }
+
   cosmo->data.E = E;
   cosmo->data.chi = chi;
   cosmo->data.achi=achi;
+  cosmo->data.tab_E = tab_E;
+  cosmo->data.tab_chi = tab_chi;
+  cosmo->data.tab_achi = tab_achi;
   cosmo->computed_distances = true;
 
   free(a);
@@ -617,9 +659,9 @@ void ccl_cosmology_compute_growth(ccl_cosmology * cosmo, int * status)
     return;
   }
 
-  chistatus|=growth_factor_and_growth_rate(1.,&growth0,&fgrowth0,cosmo, status);
-  for(int i=0; i<na; i++) {
-    chistatus|=growth_factor_and_growth_rate(a[i],&(y[i]),&(y2[i]),cosmo, status);
+  chistatus|=growth_factor_and_growth_rate(na,a,y,y2,&growth0,&fgrowth0,cosmo, status);
+  //The growth arrays are only post-processed if the integration succeeded
+  for(int i=0; (i<na) && !chistatus; i++) {
     if(cosmo->params.has_mgrowth) {
       if(a[i]>0) {
 	double df,integ;
@@ -690,12 +732,26 @@ void ccl_cosmology_compute_growth(ccl_cosmology * cosmo, int * status)
     return;
   }
 
-  // Initialize the accelerator which speeds the splines and
-  // assign all the splines we've just made to the structure.
-  if(cosmo->data.accelerator==NULL)
-    cosmo->data.accelerator=gsl_interp_accel_alloc();
+  ccl_table1d *tab_growth=ccl_table1d_new(growth);
+  ccl_table1d *tab_fgrowth=ccl_table1d_new(fgrowth);
+  if(tab_growth==NULL || tab_fgrowth==NULL) {
+    free(a);
+    free(y);
+    free(y2);
+    gsl_spline_free(growth);
+    gsl_spline_free(fgrowth);
+    ccl_table1d_free(tab_growth);
+    ccl_table1d_free(tab_fgrowth);
+    *status = CCL_ERROR_SPLINE;
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_cosmology_compute_growth(): Error creating growth tables\n");
+    return;
+  }
+
+  // Assign all the splines we've just made to the structure.
   cosmo->data.growth = growth;
   cosmo->data.fgrowth = fgrowth;
+  cosmo->data.tab_growth = tab_growth;
+  cosmo->data.tab_fgrowth = tab_fgrowth;
   cosmo->data.growth0 = growth0;
   cosmo->computed_growth = true;
 
@@ -706,6 +762,63 @@ void ccl_cosmology_compute_growth(ccl_cosmology * cosmo, int * status)
   return;
 }
 
+//Minimum number of points per thread in the array versions of the background functions
+#define CCL_BACKGROUND_CHUNK 16384
+
+/* --------- ROUTINE: eval_table_array ---------
+INPUT: cosmology, table, number of points, points, output array
+TASK: evaluate a background table over an array, splitting large arrays
+      between the cosmology's threads. Points outside the table range are set to NAN.
+*/
+static int eval_table_array(ccl_cosmology *cosmo,const ccl_table1d *tab,int n,double x[],double y[])
+{
+  int nchunk=(n+CCL_BACKGROUND_CHUNK-1)/CCL_BACKGROUND_CHUNK;
+  int gslstatus=GSL_SUCCESS;
+
+#pragma omp parallel for if(nchunk>1) num_threads(ccl_cosmology_num_threads(cosmo)) reduction(max:gslstatus)
+  for(int ic=0;ic<nchunk;ic++) {
+    int i0=ic*CCL_BACKGROUND_CHUNK;
+    int nc=(n-i0<CCL_BACKGROUND_CHUNK) ? n-i0 : CCL_BACKGROUND_CHUNK;
+    int st=ccl_table1d_eval_array(tab,nc,&(x[i0]),&(y[i0]));
+    if(st!=GSL_SUCCESS)
+      gslstatus=st;
+  }
+
+  return gslstatus;
+}
+
+/* --------- ROUTINE: flag_invalid ---------
+INPUT: cosmology, number of inputs, inputs, output array, bounds, error message
+TASK: shared by the array versions of the background functions once the output has
+      been computed. The outputs for inputs outside [lo,hi] are set to NAN, and an
+      error is raised once if there are any. The other outputs are left untouched.
+      Returns the number of invalid inputs.
+*/
+static int flag_invalid(ccl_cosmology *cosmo,int n,double x[],double output[],
+			double lo,double hi,const char *msg,int *status)
+{
+  int nbad=0;
+  for(int i=0;i<n;i++) {
+    if(!((x[i]>=lo) && (x[i]<=hi))) {
+      output[i]=NAN;
+      nbad++;
+    }
+  }
+  if(nbad>0) {
+    *status = CCL_ERROR_COMPUTECHI;
+    ccl_cosmology_set_status_message(cosmo, msg);
+    ccl_check_status(cosmo,status);
+  }
+  return nbad;
+}
+
+//Outputs for scale factors larger than 1 are invalid
+static int check_scale_factors(ccl_cosmology *cosmo,int na,double a[],double output[],int *status)
+{
+  return flag_invalid(cosmo,na,a,output,-INFINITY,1.,
+		      "ccl_background.c: scale factor cannot be larger than 1.\n",status);
+}
+
 //Expansion rate normalized to 1 today
 
 double ccl_h_over_h0(ccl_cosmology * cosmo, double a, int* status)
@@ -717,7 +830,7 @@ double ccl_h_over_h0(ccl_cosmology * cosmo, double a, int* status)
   }
 
   double h_over_h0;
-  int gslstatus = gsl_spline_eval_e(cosmo->data.E, a, cosmo->data.accelerator,&h_over_h0);
+  int gslstatus = ccl_table1d_eval_e(cosmo->data.tab_E, a, &h_over_h0);
   if(gslstatus != GSL_SUCCESS) {
     ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_h_over_h0():");
     *status = gslstatus;
@@ -731,12 +844,20 @@ double ccl_h_over_h0(ccl_cosmology * cosmo, double a, int* status)
 
 void ccl_h_over_h0s(ccl_cosmology * cosmo, int na, double a[], double output[], int * status)
 {
-  int _status;
+  if(!cosmo->computed_distances) {
+    ccl_cosmology_compute_distances(cosmo,status);
+    ccl_check_status(cosmo, status);
+  }
 
-  for (int i=0; i<na; i++) {
-    _status = 0;
-    output[i] = ccl_h_over_h0(cosmo, a[i], &_status);
-    *status |= _status;
+  int gslstatus = eval_table_array(cosmo, cosmo->data.tab_E, na, a, output);
+
+  //Only the invalid elements are set to NAN
+  if(check_scale_factors(cosmo,na,a,output,status))
+    return;
+  if(gslstatus != GSL_SUCCESS) {
+    ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_h_over_h0s():");
+    *status = CCL_ERROR_SPLINE_EV;
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_h_over_h0s(): Scale factor outside interpolation range.\n");
   }
 }
 
@@ -759,7 +880,7 @@ double ccl_comoving_radial_distance(ccl_cosmology * cosmo, double a, int * statu
     }
 
     double crd;
-    int gslstatus = gsl_spline_eval_e(cosmo->data.chi, a, cosmo->data.accelerator, &crd);
+    int gslstatus = ccl_table1d_eval_e(cosmo->data.tab_chi, a, &crd);
     if(gslstatus != GSL_SUCCESS) {
       ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_comoving_radial_distance():");
       *status = gslstatus;
@@ -772,12 +893,24 @@ double ccl_comoving_radial_distance(ccl_cosmology * cosmo, double a, int * statu
 
 void ccl_comoving_radial_distances(ccl_cosmology * cosmo, int na, double a[], double output[], int* status)
 {
-  int _status;
+  if(!cosmo->computed_distances) {
+    ccl_cosmology_compute_distances(cosmo, status);
+    ccl_check_status(cosmo,status);
+  }
 
-  for (int i=0; i<na; i++) {
-    _status = 0;
-    output[i] = ccl_comoving_radial_distance(cosmo, a[i], &_status);
-    *status |= _status;
+  int gslstatus = eval_table_array(cosmo, cosmo->data.tab_chi, na, a, output);
+  for(int i=0; i<na; i++) {
+    if((a[i] > (1.0 - 1.e-8)) && (a[i] <= 1.0))
+      output[i] = 0.;
+  }
+
+  //Only the invalid elements are set to NAN
+  if(check_scale_factors(cosmo,na,a,output,status))
+    return;
+  if(gslstatus != GSL_SUCCESS) {
+    ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_comoving_radial_distances():");
+    *status = CCL_ERROR_SPLINE_EV;
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_comoving_radial_distances(): Scale factor outside interpolation range.\n");
   }
 }
 
@@ -820,8 +953,7 @@ double ccl_comoving_angular_distance(ccl_cosmology * cosmo, double a, int* statu
     }
 
     double chi;
-    int gslstatus = gsl_spline_eval_e(cosmo->data.chi, a,
-                                      cosmo->data.accelerator,&chi);
+    int gslstatus = ccl_table1d_eval_e(cosmo->data.tab_chi, a, &chi);
     if(gslstatus != GSL_SUCCESS) {
       ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_comoving_angular_distance():");
       *status |= gslstatus;
@@ -835,12 +967,11 @@ double ccl_comoving_angular_distance(ccl_cosmology * cosmo, double a, int* statu
 void ccl_comoving_angular_distances(ccl_cosmology * cosmo, int na, double a[],
                                     double output[], int* status)
 {
-  int _status;
+  ccl_comoving_radial_distances(cosmo, na, a, output, status);
 
-  for (int i=0; i < na; i++) {
-    _status = 0;
-    output[i] = ccl_comoving_angular_distance(cosmo, a[i], &_status);
-    *status |= _status;
+  if(cosmo->params.k_sign != 0) {
+    for (int i=0; i < na; i++)
+      output[i] = ccl_sinn(cosmo, output[i], status);
   }
 }
 
@@ -851,13 +982,10 @@ double ccl_luminosity_distance(ccl_cosmology * cosmo, double a, int* status)
 
 void ccl_luminosity_distances(ccl_cosmology * cosmo, int na, double a[], double output[], int * status)
 {
-  int _status;
+  ccl_comoving_angular_distances(cosmo, na, a, output, status);
 
-  for (int i=0; i<na; i++) {
-    _status = 0;
-    output[i] = ccl_luminosity_distance(cosmo, a[i], &_status);
-    *status |= _status;
-  }
+  for (int i=0; i<na; i++)
+    output[i] /= a[i];
 }
 
 double ccl_distance_modulus(ccl_cosmology * cosmo, double a, int* status)
@@ -889,12 +1017,23 @@ double ccl_distance_modulus(ccl_cosmology * cosmo, double a, int* status)
 
 void ccl_distance_moduli(ccl_cosmology * cosmo, int na, double a[], double output[], int * status)
 {
-  int _status;
+  ccl_luminosity_distances(cosmo, na, a, output, status);
+
+  for (int i=0; i<na; i++)
+    output[i] = 5 * log10(output[i]) + 25;
 
+  //The distance modulus is undefined at a=1
+  int n_today=0;
   for (int i=0; i<na; i++) {
-    _status = 0;
-    output[i] = ccl_distance_modulus(cosmo, a[i], &_status);
-    *status |= _status;
+    if((a[i] > (1.0 - 1.e-8)) && (a[i]<=1.0)) {
+      output[i] = NAN;
+      n_today++;
+    }
+  }
+  if(n_today>0) {
+    *status = CCL_ERROR_COMPUTECHI;
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: distance_modulus undefined for a=1.\n");
+    ccl_check_status(cosmo,status);
   }
 }
 
@@ -916,7 +1055,7 @@ double ccl_scale_factor_of_chi(ccl_cosmology * cosmo, double chi, int * status)
       ccl_check_status(cosmo,status);
     }
     double a;
-    int gslstatus = gsl_spline_eval_e(cosmo->data.achi, chi,cosmo->data.accelerator_achi, &a);
+    int gslstatus = ccl_table1d_eval_e(cosmo->data.tab_achi, chi, &a);
     if(gslstatus != GSL_SUCCESS) {
       ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_scale_factor_of_chi():");
       *status |= gslstatus;
@@ -928,12 +1067,25 @@ double ccl_scale_factor_of_chi(ccl_cosmology * cosmo, double chi, int * status)
 //
 void ccl_scale_factor_of_chis(ccl_cosmology * cosmo, int nchi, double chi[], double output[], int * status)
 {
-  int _status;
+  if (!cosmo->computed_distances) {
+    ccl_cosmology_compute_distances(cosmo,status);
+    ccl_check_status(cosmo,status);
+  }
 
+  int gslstatus = eval_table_array(cosmo, cosmo->data.tab_achi, nchi, chi, output);
   for (int i=0; i<nchi; i++) {
-    _status = 0;
-    output[i] = ccl_scale_factor_of_chi(cosmo, chi[i], &_status);
-    *status |= _status;
+    if((chi[i] < 1.e-8) && (chi[i] >= 0.))
+      output[i] = 1.;
+  }
+
+  //Only the invalid elements are set to NAN
+  if(flag_invalid(cosmo,nchi,chi,output,0.,INFINITY,
+		  "ccl_background.c: distance cannot be smaller than 0.\n",status))
+    return;
+  if(gslstatus != GSL_SUCCESS) {
+    ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_scale_factor_of_chis():");
+    *status = CCL_ERROR_SPLINE_EV;
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_scale_factor_of_chis(): Distance outside interpolation range.\n");
   }
 }
 
@@ -955,7 +1107,7 @@ double ccl_growth_factor(ccl_cosmology * cosmo, double a, int * status)
     }
     if (*status!= CCL_ERROR_NOT_IMPLEMENTED) {
       double D;
-      int gslstatus = gsl_spline_eval_e(cosmo->data.growth, a, cosmo->data.accelerator,&D);
+      int gslstatus = ccl_table1d_eval_e(cosmo->data.tab_growth, a, &D);
       if(gslstatus != GSL_SUCCESS) {
         ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_growth_factor():");
         *status |= gslstatus;
@@ -972,12 +1124,29 @@ double ccl_growth_factor(ccl_cosmology * cosmo, double a, int * status)
 
 void ccl_growth_factors(ccl_cosmology * cosmo, int na, double a[], double output[], int * status)
 {
-  int _status;
+  if (!cosmo->computed_growth) {
+    ccl_cosmology_compute_growth(cosmo, status);
+    ccl_check_status(cosmo, status);
+  }
+  if (*status == CCL_ERROR_NOT_IMPLEMENTED) {
+    for (int i=0; i<na; i++)
+      output[i] = NAN;
+    return;
+  }
 
+  int gslstatus = eval_table_array(cosmo, cosmo->data.tab_growth, na, a, output);
   for (int i=0; i<na; i++) {
-    _status = 0;
-    output[i] = ccl_growth_factor(cosmo, a[i], &_status);
-    *status |= _status;
+    if(a[i]==1.)
+      output[i] = 1.;
+  }
+
+  //Only the invalid elements are set to NAN
+  if(check_scale_factors(cosmo,na,a,output,status))
+    return;
+  if(gslstatus != GSL_SUCCESS) {
+    ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_growth_factors():");
+    *status = CCL_ERROR_SPLINE_EV;
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_growth_factors(): Scale factor outside interpolation range.\n");
   }
 }
 
@@ -998,12 +1167,11 @@ double ccl_growth_factor_unnorm(ccl_cosmology * cosmo, double a, int * status)
 
 void ccl_growth_factors_unnorm(ccl_cosmology * cosmo, int na, double a[], double output[], int * status)
 {
-  int _status;
+  ccl_growth_factors(cosmo, na, a, output, status);
 
-  for (int i=0; i<na; i++) {
-    _status = 0;
-    output[i] = ccl_growth_factor_unnorm(cosmo, a[i], &_status);
-    *status |= _status;
+  if (*status != CCL_ERROR_NOT_IMPLEMENTED) {
+    for (int i=0; i<na; i++)
+      output[i] *= cosmo->data.growth0;
   }
 }
 
@@ -1021,7 +1189,7 @@ double ccl_growth_rate(ccl_cosmology * cosmo, double a, int * status)
     }
     if(*status != CCL_ERROR_NOT_IMPLEMENTED) {
       double g;
-      int gslstatus = gsl_spline_eval_e(cosmo->data.fgrowth, a, cosmo->data.accelerator,&g);
+      int gslstatus = ccl_table1d_eval_e(cosmo->data.tab_fgrowth, a, &g);
       if(gslstatus != GSL_SUCCESS) {
         ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_growth_rate():");
         *status |= gslstatus;
@@ -1037,11 +1205,24 @@ double ccl_growth_rate(ccl_cosmology * cosmo, double a, int * status)
 
 void ccl_growth_rates(ccl_cosmology * cosmo, int na, double a[], double output[], int * status)
 {
-  int _status;
+  if (!cosmo->computed_growth) {
+    ccl_cosmology_compute_growth(cosmo, status);
+    ccl_check_status(cosmo, status);
+  }
+  if (*status == CCL_ERROR_NOT_IMPLEMENTED) {
+    for (int i=0; i<na; i++)
+      output[i] = NAN;
+    return;
+  }
 
-  for (int i=0; i<na; i++) {
-    _status = 0;
-    output[i] = ccl_growth_rate(cosmo, a[i], &_status);
-    *status |= _status;
+  int gslstatus = eval_table_array(cosmo, cosmo->data.tab_fgrowth, na, a, output);
+
+  //Only the invalid elements are set to NAN
+  if(check_scale_factors(cosmo,na,a,output,status))
+    return;
+  if(gslstatus != GSL_SUCCESS) {
+    ccl_raise_gsl_warning(gslstatus, "ccl_background.c: ccl_growth_rates():");
+    *status = CCL_ERROR_SPLINE_EV;
+    ccl_cosmology_set_status_message(cosmo, "ccl_background.c: ccl_growth_rates(): Scale factor outside interpolation range.\n");
   }
 }
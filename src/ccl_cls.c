@@ -5,6 +5,9 @@
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_integration.h>
+#include <gsl/gsl_linalg.h>
+
+#include "fftlog.h"
 
 #include "ccl.h"
 
@@ -55,6 +58,27 @@ static double speval_bis(double x,void *params)
   return ccl_spline_eval(x,(SplPar *)params);
 }
 
+//Same as speval_bis, multiplied by x
+static double speval_x(double x,void *params)
+{
+  return x*ccl_spline_eval(x,(SplPar *)params);
+}
+
+//Normalized N(z) of a tracer, including the photo-z shift and stretch:
+//  N'(z) = N(z_mean+(z-z_mean-dz)/stretch)/stretch
+//The argument is written so that it is exactly z for dz=0 and stretch=1.
+static double cl_tracer_nz(CCL_ClTracer *clt,double z)
+{
+  double z_in=z-(clt->nz_shift+(clt->nz_stretch-1)*(z-clt->nz_mean))/clt->nz_stretch;
+  return ccl_spline_eval(z_in,clt->spl_nz)/clt->nz_stretch;
+}
+
+//Maps a redshift of the input N(z) into the shifted and stretched one
+static double cl_tracer_photoz_z(CCL_ClTracer *clt,double z)
+{
+  return fmax(0.,z+clt->nz_shift+(clt->nz_stretch-1)*(z-clt->nz_mean));
+}
+
 
 void ccl_cl_workspace_free(CCL_ClWorkspace *w)
 {
@@ -84,7 +108,8 @@ CCL_ClWorkspace *ccl_cl_workspace_default(int lmax,int l_limber,int non_limber_m
   }
   w->zmin=zmin;
   w->lmax=lmax;
-  if((non_limber_method!=CCL_NONLIMBER_METHOD_NATIVE) && (non_limber_method!=CCL_NONLIMBER_METHOD_ANGPOW)) {
+  if((non_limber_method!=CCL_NONLIMBER_METHOD_NATIVE) && (non_limber_method!=CCL_NONLIMBER_METHOD_ANGPOW) &&
+     (non_limber_method!=CCL_NONLIMBER_METHOD_FFTLOG) && (non_limber_method!=CCL_NONLIMBER_METHOD_LEVIN)) {
     free(w);
     *status=CCL_ERROR_INCONSISTENT;
     //Can't access cosmology object
@@ -92,6 +117,9 @@ CCL_ClWorkspace *ccl_cl_workspace_default(int lmax,int l_limber,int non_limber_m
     return NULL;
   }
   w->nlimb_method=non_limber_method;
+  w->limber_method=CCL_LIMBER_METHOD_QAG;
+  w->dlchi=CCL_LIMBER_GRID_DLCHI;
+  w->l_epsrel=0;
   w->l_limber=l_limber;
   w->l_logstep=l_logstep;
   w->l_linstep=l_linstep;
@@ -148,130 +176,195 @@ CCL_ClWorkspace *ccl_cl_workspace_default_limber(int lmax,double l_logstep,int l
   return ccl_cl_workspace_default(lmax,-1,CCL_NONLIMBER_METHOD_NATIVE,l_logstep,l_linstep,3.,dlk,0.05,status);
 }
 
-//Params for lensing kernel integrand
-typedef struct {
-  double chi;
-  SplPar *spl_pz;
-  ccl_cosmology *cosmo;
-  int *status;
-} IntLensPar;
-
-//Integrand for lensing kernel
-static double integrand_wl(double chip,void *params)
+//Cosine-like counterpart of ccl_sinn, such that
+//sinn(chi'-chi)=sinn(chi')*cosn(chi)-cosn(chi')*sinn(chi)
+static double cosn(ccl_cosmology *cosmo,double chi)
 {
-  IntLensPar *p=(IntLensPar *)params;
-  double chi=p->chi;
-  double a=ccl_scale_factor_of_chi(p->cosmo,chip, p->status);
-  double z=1./a-1;
-  double pz=ccl_spline_eval(z,p->spl_pz);
-  double h=p->cosmo->params.h*ccl_h_over_h0(p->cosmo,a, p->status)/CLIGHT_HMPC;
-
-  if(chi==0)
-    return h*pz;
-  else
-    return h*pz*ccl_sinn(p->cosmo,chip-chi,p->status)/ccl_sinn(p->cosmo,chip,p->status);
+  switch(cosmo->params.k_sign) {
+  case -1:
+    return cosh(cosmo->params.sqrtk*chi);
+  case 1:
+    return cos(cosmo->params.sqrtk*chi);
+  default:
+    return 1;
+  }
 }
 
-//Integral to compute lensing window function
-//chi     -> comoving distance
-//cosmo   -> ccl_cosmology object
-//spl_pz  -> normalized N(z) spline
-//chi_max -> maximum comoving distance to which the integral is computed
-//win     -> result is stored here
-static int window_lensing(double chi,ccl_cosmology *cosmo,SplPar *spl_pz,double chi_max,double *win)
-{
-  int gslstatus =0, status =0;
-  double result,eresult;
-  IntLensPar ip;
-  gsl_function F;
-  gsl_integration_workspace *w=gsl_integration_workspace_alloc(ccl_gsl->N_ITERATION);
+//Spacing in chi (in Mpc) of the nodes of the lensing and magnification window splines
+#define CCL_WL_DCHI 5.
+//Minimum number of Simpson panels across the support of N(z) in the window integrals
+#define CCL_WL_NPANEL_NZ 64
+//Maximum number of Simpson panels per spline node interval
+#define CCL_WL_NSUB_MAX 64
+
+//Lensing or magnification window function at all nodes of a linearly-spaced grid in chi
+//  W(chi) = \int_chi^chi_max dchi' q(chi') sinn(chi'-chi)/sinn(chi'),
+//with q = H(z)*N(z), times (1-2.5*s(z)) for magnification, and chi_max the last node.
+//The geometric factor separates as cosn(chi)-sinn(chi)*cosn(chi')/sinn(chi'), so that
+//W(chi) = cosn(chi)*A(chi)-sinn(chi)*B(chi), where A and B are the integrals of q and
+//q*cosn/sinn above chi. These are accumulated downwards from chi_max in a single pass,
+//using Simpson's rule on nsub panels per interval, so that the integration step can
+//resolve an N(z) narrower than the node spacing.
+//cosmo  -> ccl_cosmology object
+//clt    -> tracer whose N(z) is used
+//spl_sz -> magnification bias s(z) (NULL for lensing)
+//nchi   -> number of nodes
+//chi    -> nodes, linearly spaced starting at chi=0
+//nsub   -> number of Simpson panels per interval between nodes
+//win    -> result is stored here
+static int window_lensing(ccl_cosmology *cosmo,CCL_ClTracer *clt,SplPar *spl_sz,
+			  int nchi,double *chi,int nsub,double *win)
+{
+  int j,status=0;
+  int npan=nsub*(nchi-1);
+  int np=2*npan+1;
+  //Points at the panel edges (even) and at the middle of each panel (odd)
+  double *chip=(double *)malloc(3*np*sizeof(double));
+  if(chip==NULL)
+    return 1;
+  double *a=&(chip[np]);
+  double *q=&(chip[2*np]);
 
-  ip.chi=chi;
-  ip.cosmo=cosmo;
-  ip.spl_pz=spl_pz;
-  ip.status = &status;
-  F.function=&integrand_wl;
-  F.params=&ip;
-  gslstatus=gsl_integration_qag(&F, chi, chi_max, 0,
-                                ccl_gsl->INTEGRATION_EPSREL, ccl_gsl->N_ITERATION,
-                                ccl_gsl->INTEGRATION_GAUSS_KRONROD_POINTS,
-                                w, &result, &eresult);
-  *win=result;
-  gsl_integration_workspace_free(w);
-  if(gslstatus!=GSL_SUCCESS || *ip.status) {
-    ccl_raise_gsl_warning(gslstatus, "ccl_cls.c: window_lensing():");
+  for(j=0;j<np-1;j++) {
+    int jn=j/(2*nsub);
+    chip[j]=chi[jn]+(chi[jn+1]-chi[jn])*(j-2*nsub*jn)/(2.*nsub);
+  }
+  chip[np-1]=chi[nchi-1];
+  ccl_scale_factor_of_chis(cosmo,np,chip,a,&status);
+  ccl_h_over_h0s(cosmo,np,a,q,&status);
+  if(status) {
+    free(chip);
     return 1;
   }
-  //TODO: chi_max should be changed to chi_horizon
-  //we should precompute this quantity and store it in cosmo by default
+  for(j=0;j<np;j++) {
+    double z=1./a[j]-1;
+    q[j]*=cosmo->params.h*cl_tracer_nz(clt,z)/CLIGHT_HMPC;
+    if(spl_sz!=NULL)
+      q[j]*=1-2.5*ccl_spline_eval(z,spl_sz);
+  }
 
-  return 0;
-}
+  //Accumulate A and B downwards
+  double cum_a=0,cum_b=0;
+  double qb_hi=q[np-1]*cosn(cosmo,chip[np-1])/ccl_sinn(cosmo,chip[np-1],&status);
+  win[nchi-1]=0;
+  for(j=npan-1;j>=0;j--) {
+    int i_lo=2*j,i_mid=2*j+1,i_hi=2*j+2;
+    //The integrand of B is only needed at chi'>0 (for chi=0, sinn(chi)=0)
+    double qb_lo=(chip[i_lo]>0) ? q[i_lo]*cosn(cosmo,chip[i_lo])/ccl_sinn(cosmo,chip[i_lo],&status) : 0;
+    double qb_mid=q[i_mid]*cosn(cosmo,chip[i_mid])/ccl_sinn(cosmo,chip[i_mid],&status);
+    double dchi=chip[i_hi]-chip[i_lo];
+    cum_a+=dchi*(q[i_lo]+4*q[i_mid]+q[i_hi])/6;
+    cum_b+=dchi*(qb_lo+4*qb_mid+qb_hi)/6;
+    if(j%nsub==0) {
+      int jn=j/nsub;
+      win[jn]=cosn(cosmo,chi[jn])*cum_a-ccl_sinn(cosmo,chi[jn],&status)*cum_b;
+    }
+    qb_hi=qb_lo;
+  }
+  free(chip);
 
-//Params for lensing kernel integrand
-typedef struct {
-  double chi;
-  SplPar *spl_pz;
-  SplPar *spl_sz;
-  ccl_cosmology *cosmo;
-  int *status;
-} IntMagPar;
+  return status ? 1 : 0;
+}
 
-//Integrand for magnification kernel
-static double integrand_mag(double chip,void *params)
+//Computes the lensing window of a tracer (or the magnification window if spl_sz!=NULL)
+//and stores it in *spl_w. The memory of an existing window spline is reused.
+static void cl_tracer_window(ccl_cosmology *cosmo,CCL_ClTracer *clt,SplPar *spl_sz,
+			     SplPar **spl_w,int *status)
 {
-  IntMagPar *p=(IntMagPar *)params;
-//EK: added local status here as the status testing is done in routines called from this function
-  double chi=p->chi;
-  double a=ccl_scale_factor_of_chi(p->cosmo,chip, p->status);
-  double z=1./a-1;
-  double pz=ccl_spline_eval(z,p->spl_pz);
-  double sz=ccl_spline_eval(z,p->spl_sz);
-  double h=p->cosmo->params.h*ccl_h_over_h0(p->cosmo,a, p->status)/CLIGHT_HMPC;
-
-  if(chi==0)
-    return h*pz*(1-2.5*sz);
+  int nchi,nsub;
+  double *x,*y;
+  double zmax=cl_tracer_photoz_z(clt,clt->spl_nz->xf);
+  double chimax=ccl_comoving_radial_distance(cosmo,1./(1+zmax),status);
+  //Width in chi of the support of N(z), which sets the integration step
+  double chi_nz=ccl_comoving_radial_distance(cosmo,1./(1+cl_tracer_photoz_z(clt,clt->nz_zmax)),status)-
+    ccl_comoving_radial_distance(cosmo,1./(1+cl_tracer_photoz_z(clt,clt->nz_zmin)),status);
+
+  nchi=(int)(chimax/CCL_WL_DCHI)+1;
+  if(chi_nz>0)
+    nsub=(int)ceil(CCL_WL_NPANEL_NZ*CCL_WL_DCHI/chi_nz);
   else
-    return h*pz*(1-2.5*sz)*ccl_sinn(p->cosmo,chip-chi,p->status)/ccl_sinn(p->cosmo,chip,p->status);
+    nsub=CCL_WL_NSUB_MAX;
+  nsub=CCL_MIN(CCL_MAX(nsub,1),CCL_WL_NSUB_MAX);
+  x=ccl_linear_spacing(0.,chimax,nchi);
+  if(x==NULL || (fabs(x[0]-0)>1E-5) || (fabs(x[nchi-1]-chimax)>1e-5)) {
+    free(x);
+    *status=CCL_ERROR_LINSPACE;
+    ccl_cosmology_set_status_message(cosmo,
+	   "ccl_cls.c: ccl_cl_tracer(): Error creating linear spacing in chi\n");
+    return;
+  }
+  y=(double *)malloc(nchi*sizeof(double));
+  if(y==NULL) {
+    free(x);
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): memory allocation\n");
+    return;
+  }
+
+  if(window_lensing(cosmo,clt,spl_sz,nchi,x,nsub,y)) {
+    *status=CCL_ERROR_INTEG;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): error computing lensing window\n");
+  }
+  else {
+    *spl_w=ccl_spline_reinit(*spl_w,nchi,x,y,y[0],0);
+    if(*spl_w==NULL) {
+      *status=CCL_ERROR_SPLINE;
+      ccl_cosmology_set_status_message(cosmo,
+	     "ccl_cls.c: ccl_cl_tracer(): error initializing spline for lensing window\n");
+    }
+  }
+  free(x); free(y);
 }
 
-//Integral to compute magnification window function
-//chi     -> comoving distance
-//cosmo   -> ccl_cosmology object
-//spl_pz  -> normalized N(z) spline
-//spl_pz  -> magnification bias s(z)
-//chi_max -> maximum comoving distance to which the integral is computed
-//win     -> result is stored here
-static int window_magnification(double chi,ccl_cosmology *cosmo,SplPar *spl_pz,SplPar *spl_sz,
-				double chi_max,double *win)
-{
-  int gslstatus =0, status =0;
-  double result,eresult;
-  IntMagPar ip;
-  gsl_function F;
-  gsl_integration_workspace *w=gsl_integration_workspace_alloc(ccl_gsl->N_ITERATION);
+//Frees the transfer functions of a tracer
+static void cl_tracer_free_transfer(CCL_ClTracer *clt)
+{
+  if(clt->computed_transfer) {
+    int il;
+    free(clt->n_k);
+    for(il=0;il<clt->n_ls;il++)
+      ccl_spline_free(clt->spl_transfer[il]);
+    free(clt->spl_transfer);
+  }
+  clt->computed_transfer=0;
+}
 
-  ip.chi=chi;
-  ip.cosmo=cosmo;
-  ip.spl_pz=spl_pz;
-  ip.spl_sz=spl_sz;
-  ip.status = &status;
-  F.function=&integrand_mag;
-  F.params=&ip;
-  gslstatus=gsl_integration_qag(&F, chi, chi_max, 0,
-                                ccl_gsl->INTEGRATION_EPSREL, ccl_gsl->N_ITERATION,
-                                ccl_gsl->INTEGRATION_GAUSS_KRONROD_POINTS,
-                                w, &result, &eresult);
-  *win=result;
-  gsl_integration_workspace_free(w);
-  if(gslstatus!=GSL_SUCCESS || *ip.status) {
-    ccl_raise_gsl_warning(gslstatus, "ccl_cls.c: window_magnification():");
-    return 1;
+//Computes all the quantities of a tracer that depend on the cosmology or on the photo-z
+//parameters: the lensing prefactor, the limits in chi and the lensing and magnification windows.
+//The input redshift-dependent functions (N(z), b(z), s(z), IA) are left untouched.
+static void cl_tracer_bind(ccl_cosmology *cosmo,CCL_ClTracer *clt,int *status)
+{
+  if ( ((cosmo->params.N_nu_mass)>0) && clt->tracer_type==CL_TRACER_NC && clt->has_rsd){
+    *status=CCL_ERROR_NOT_IMPLEMENTED;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer_new(): Number counts tracers with rsd not yet implemented in cosmologies with massive neutrinos.");
+    return;
   }
-  //TODO: chi_max should be changed to chi_horizon
-  //we should precompute this quantity and store it in cosmo by default
 
-  return 0;
+  //Transfer functions computed for a previous cosmology are no longer valid
+  cl_tracer_free_transfer(clt);
+
+  double hub=cosmo->params.h*ccl_h_over_h0(cosmo,1.,status)/CLIGHT_HMPC;
+  clt->prefac_lensing=1.5*hub*hub*cosmo->params.Omega_m;
+
+  if((clt->tracer_type==CL_TRACER_NC)||(clt->tracer_type==CL_TRACER_WL)) {
+    clt->zmax=cl_tracer_photoz_z(clt,clt->nz_zmax);
+    //Lensing and magnification need to be integrated all the way to z=0
+    if((clt->tracer_type==CL_TRACER_WL) || clt->has_magnification)
+      clt->zmin=0;
+    else
+      clt->zmin=cl_tracer_photoz_z(clt,clt->nz_zmin);
+    clt->chimax=ccl_comoving_radial_distance(cosmo,1./(1+clt->zmax),status);
+    clt->chimin=ccl_comoving_radial_distance(cosmo,1./(1+clt->zmin),status);
+    if((clt->tracer_type==CL_TRACER_NC) && clt->has_magnification)
+      cl_tracer_window(cosmo,clt,clt->spl_sz,&(clt->spl_wM),status);
+    else if(clt->tracer_type==CL_TRACER_WL)
+      cl_tracer_window(cosmo,clt,NULL,&(clt->spl_wL),status);
+  }
+  else if(clt->tracer_type==CL_TRACER_CL) {
+    clt->chi_source=ccl_comoving_radial_distance(cosmo,1./(1+clt->z_source),status);
+    clt->chimax=clt->chi_source;
+    clt->chimin=0;
+  }
 }
 
 //CCL_ClTracer creator
@@ -294,7 +387,7 @@ static CCL_ClTracer *cl_tracer(ccl_cosmology *cosmo,int tracer_type,
 				   int nz_rf,double *z_rf,double *rf,
 				   double z_source, int * status)
 {
-  int clstatus=0, gslstatus;
+  int gslstatus;
   CCL_ClTracer *clt=(CCL_ClTracer *)malloc(sizeof(CCL_ClTracer));
   if(clt==NULL) {
 
@@ -303,38 +396,41 @@ static CCL_ClTracer *cl_tracer(ccl_cosmology *cosmo,int tracer_type,
     return NULL;
   }
 
-  if ( ((cosmo->params.N_nu_mass)>0) && tracer_type==CL_TRACER_NC && has_rsd){
-	  free(clt);
-	  *status=CCL_ERROR_NOT_IMPLEMENTED;
-	  ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer_new(): Number counts tracers with rsd not yet implemented in cosmologies with massive neutrinos.");
-	  return NULL;
-  }
-
   clt->tracer_type=tracer_type;
+  clt->has_density=1;
+  clt->has_rsd=0;
+  clt->has_magnification=0;
+  clt->has_intrinsic_alignment=0;
+  clt->z_source=z_source;
+  clt->nz_mean=0;
+  clt->nz_shift=0;
+  clt->nz_stretch=1;
+  clt->spl_nz=NULL;
+  clt->spl_bz=NULL;
+  clt->spl_sz=NULL;
+  clt->spl_rf=NULL;
+  clt->spl_ba=NULL;
+  clt->spl_wL=NULL;
+  clt->spl_wM=NULL;
   clt->computed_transfer=0;
-
-  double hub=cosmo->params.h*ccl_h_over_h0(cosmo,1.,status)/CLIGHT_HMPC;
-  clt->prefac_lensing=1.5*hub*hub*cosmo->params.Omega_m;
+  clt->transfer_method=CCL_NONLIMBER_METHOD_NATIVE;
 
   if((tracer_type==CL_TRACER_NC)||(tracer_type==CL_TRACER_WL)) {
-    get_support_interval(nz_n,z_n,n,CCL_FRAC_RELEVANT,&(clt->zmin),&(clt->zmax));
-    clt->chimax=ccl_comoving_radial_distance(cosmo,1./(1+clt->zmax),status);
-    clt->chimin=ccl_comoving_radial_distance(cosmo,1./(1+clt->zmin),status);
+    get_support_interval(nz_n,z_n,n,CCL_FRAC_RELEVANT,&(clt->nz_zmin),&(clt->nz_zmax));
     clt->spl_nz=ccl_spline_init(nz_n,z_n,n,0,0);
     if(clt->spl_nz==NULL) {
-      free(clt);
+      ccl_cl_tracer_free(clt);
       *status=CCL_ERROR_SPLINE;
       ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): error initializing spline for N(z)\n");
       return NULL;
     }
 
-    //Normalize n(z)
+    //Normalize n(z) and compute its mean
     gsl_function F;
-    double nz_norm,nz_enorm;
+    double nz_norm,nz_enorm,nz_zint;
     double *nz_normalized=(double *)malloc(nz_n*sizeof(double));
     if(nz_normalized==NULL) {
-      ccl_spline_free(clt->spl_nz);
-      free(clt);
+      ccl_cl_tracer_free(clt);
       *status=CCL_ERROR_MEMORY;
       ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): memory allocation\n");
       return NULL;
@@ -347,22 +443,29 @@ static CCL_ClTracer *cl_tracer(ccl_cosmology *cosmo,int tracer_type,
                                   ccl_gsl->INTEGRATION_EPSREL, ccl_gsl->N_ITERATION,
                                   ccl_gsl->INTEGRATION_GAUSS_KRONROD_POINTS,
                                   w, &nz_norm, &nz_enorm);
+    if(gslstatus==GSL_SUCCESS) {
+      F.function=&speval_x;
+      gslstatus=gsl_integration_qag(&F, z_n[0], z_n[nz_n-1], 0,
+				    ccl_gsl->INTEGRATION_EPSREL, ccl_gsl->N_ITERATION,
+				    ccl_gsl->INTEGRATION_GAUSS_KRONROD_POINTS,
+				    w, &nz_zint, &nz_enorm);
+    }
     gsl_integration_workspace_free(w);
     if(gslstatus!=GSL_SUCCESS) {
       ccl_raise_gsl_warning(gslstatus, "ccl_cls.c: cl_tracer():");
-      ccl_spline_free(clt->spl_nz);
-      free(clt);
+      free(nz_normalized);
+      ccl_cl_tracer_free(clt);
       *status=CCL_ERROR_INTEG;
       ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): integration error when normalizing N(z)\n");
       return NULL;
     }
+    clt->nz_mean=nz_zint/nz_norm;
     for(int ii=0;ii<nz_n;ii++)
       nz_normalized[ii]=n[ii]/nz_norm;
-    ccl_spline_free(clt->spl_nz);
-    clt->spl_nz=ccl_spline_init(nz_n,z_n,nz_normalized,0,0);
+    clt->spl_nz=ccl_spline_reinit(clt->spl_nz,nz_n,z_n,nz_normalized,0,0);
     free(nz_normalized);
     if(clt->spl_nz==NULL) {
-      free(clt);
+      ccl_cl_tracer_free(clt);
       *status=CCL_ERROR_SPLINE;
       ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): error initializing normalized spline for N(z)\n");
       return NULL;
@@ -372,8 +475,7 @@ static CCL_ClTracer *cl_tracer(ccl_cosmology *cosmo,int tracer_type,
       //Initialize bias spline
       clt->spl_bz=ccl_spline_init(nz_b,z_b,b,b[0],b[nz_b-1]);
       if(clt->spl_bz==NULL) {
-	ccl_spline_free(clt->spl_nz);
-	free(clt);
+	ccl_cl_tracer_free(clt);
 	*status=CCL_ERROR_SPLINE;
 	ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): error initializing spline for b(z)\n");
 	return NULL;
@@ -381,147 +483,22 @@ static CCL_ClTracer *cl_tracer(ccl_cosmology *cosmo,int tracer_type,
       clt->has_rsd=has_rsd;
       clt->has_magnification=has_magnification;
       if(clt->has_magnification) {
-	//Compute weak lensing kernel
-	int nchi;
-	double *x,*y;
-	double dchi_here=5.;
-	double zmax=clt->spl_nz->xf;
-	double chimax=ccl_comoving_radial_distance(cosmo,1./(1+zmax),status);
-	//TODO: The interval in chi (5. Mpc) should be made a macro
-
-	//In this case we need to integrate all the way to z=0. Reset zmin and chimin
-	clt->zmin=0;
-	clt->chimin=0;
 	clt->spl_sz=ccl_spline_init(nz_s,z_s,s,s[0],s[nz_s-1]);
 	if(clt->spl_sz==NULL) {
-	  ccl_spline_free(clt->spl_nz);
-	  ccl_spline_free(clt->spl_bz);
-	  free(clt);
+	  ccl_cl_tracer_free(clt);
 	  *status=CCL_ERROR_SPLINE;
 	  ccl_cosmology_set_status_message(cosmo,
 		 "ccl_cls.c: ccl_cl_tracer(): error initializing spline for s(z)\n");
 	  return NULL;
 	}
-
-	nchi=(int)(chimax/dchi_here)+1;
-	x=ccl_linear_spacing(0.,chimax,nchi);
-	dchi_here=chimax/nchi;
-	if(x==NULL || (fabs(x[0]-0)>1E-5) || (fabs(x[nchi-1]-chimax)>1e-5)) {
-	  ccl_spline_free(clt->spl_nz);
-	  ccl_spline_free(clt->spl_bz);
-	  ccl_spline_free(clt->spl_sz);
-	  free(clt);
-	  *status=CCL_ERROR_LINSPACE;
-	  ccl_cosmology_set_status_message(cosmo,
-		 "ccl_cls.c: ccl_cl_tracer(): Error creating linear spacing in chi\n");
-	  return NULL;
-	}
-	y=(double *)malloc(nchi*sizeof(double));
-	if(y==NULL) {
-	  free(x);
-	  ccl_spline_free(clt->spl_nz);
-	  ccl_spline_free(clt->spl_bz);
-	  ccl_spline_free(clt->spl_sz);
-	  free(clt);
-	  *status=CCL_ERROR_MEMORY;
-	  ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): memory allocation\n");
-	  return NULL;
-	}
-
-	for(int j=0;j<nchi;j++)
-	  clstatus|=window_magnification(x[j],cosmo,clt->spl_nz,clt->spl_sz,chimax,&(y[j]));
-	if(clstatus) {
-	  free(y);
-	  free(x);
-	  ccl_spline_free(clt->spl_nz);
-	  ccl_spline_free(clt->spl_bz);
-	  ccl_spline_free(clt->spl_sz);
-	  free(clt);
-	  *status=CCL_ERROR_INTEG;
-	  ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): error computing lensing window\n");
-	  return NULL;
-	}
-
-	clt->spl_wM=ccl_spline_init(nchi,x,y,y[0],0);
-	if(clt->spl_wM==NULL) {
-	  free(y);
-	  free(x);
-	  ccl_spline_free(clt->spl_nz);
-	  ccl_spline_free(clt->spl_bz);
-	  ccl_spline_free(clt->spl_sz);
-	  free(clt);
-	  *status=CCL_ERROR_SPLINE;
-	  ccl_cosmology_set_status_message(cosmo,
-		 "ccl_cls.c: ccl_cl_tracer(): error initializing spline for lensing window\n");
-	  return NULL;
-	}
-	free(x); free(y);
       }
     }
     else if(tracer_type==CL_TRACER_WL) {
-      //Compute weak lensing kernel
-      int nchi;
-      double *x,*y;
-      double dchi_here=5.;
-      double zmax=clt->spl_nz->xf;
-      double chimax=ccl_comoving_radial_distance(cosmo,1./(1+zmax),status);
-      //TODO: The interval in chi (5. Mpc) should be made a macro
-
-      //In this case we need to integrate all the way to z=0. Reset zmin and chimin
-      clt->zmin=0;
-      clt->chimin=0;
-      nchi=(int)(chimax/dchi_here)+1;
-      x=ccl_linear_spacing(0.,chimax,nchi);
-      dchi_here=chimax/nchi;
-      if(x==NULL || (fabs(x[0]-0)>1E-5) || (fabs(x[nchi-1]-chimax)>1e-5)) {
-	ccl_spline_free(clt->spl_nz);
-	free(clt);
-	*status=CCL_ERROR_LINSPACE;
-	ccl_cosmology_set_status_message(cosmo,
-	       "ccl_cls.c: ccl_cl_tracer(): Error creating linear spacing in chi\n");
-	return NULL;
-      }
-      y=(double *)malloc(nchi*sizeof(double));
-      if(y==NULL) {
-	free(x);
-	ccl_spline_free(clt->spl_nz);
-	free(clt);
-	*status=CCL_ERROR_MEMORY;
-	ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): memory allocation\n");
-	return NULL;
-      }
-
-      for(int j=0;j<nchi;j++)
-	clstatus|=window_lensing(x[j],cosmo,clt->spl_nz,chimax,&(y[j]));
-      if(clstatus) {
-	free(y);
-	free(x);
-	ccl_spline_free(clt->spl_nz);
-	free(clt);
-	*status=CCL_ERROR_INTEG;
-	ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): error computing lensing window\n");
-	return NULL;
-      }
-
-      clt->spl_wL=ccl_spline_init(nchi,x,y,y[0],0);
-      if(clt->spl_wL==NULL) {
-	free(y);
-	free(x);
-	ccl_spline_free(clt->spl_nz);
-	free(clt);
-	*status=CCL_ERROR_SPLINE;
-	ccl_cosmology_set_status_message(cosmo,
-	       "ccl_cls.c: ccl_cl_tracer(): error initializing spline for lensing window\n");
-	return NULL;
-      }
-      free(x); free(y);
-
       clt->has_intrinsic_alignment=has_intrinsic_alignment;
       if(clt->has_intrinsic_alignment) {
 	clt->spl_rf=ccl_spline_init(nz_rf,z_rf,rf,rf[0],rf[nz_rf-1]);
 	if(clt->spl_rf==NULL) {
-	  ccl_spline_free(clt->spl_nz);
-	  free(clt);
+	  ccl_cl_tracer_free(clt);
 	  *status=CCL_ERROR_SPLINE;
 	  ccl_cosmology_set_status_message(cosmo,
 		 "ccl_cls.c: ccl_cl_tracer(): error initializing spline for rf(z)\n");
@@ -529,9 +506,7 @@ static CCL_ClTracer *cl_tracer(ccl_cosmology *cosmo,int tracer_type,
 	}
 	clt->spl_ba=ccl_spline_init(nz_ba,z_ba,ba,ba[0],ba[nz_ba-1]);
 	if(clt->spl_ba==NULL) {
-	  ccl_spline_free(clt->spl_rf);
-	  ccl_spline_free(clt->spl_nz);
-	  free(clt);
+	  ccl_cl_tracer_free(clt);
 	  *status=CCL_ERROR_SPLINE;
 	  ccl_cosmology_set_status_message(cosmo,
 		 "ccl_cls.c: ccl_cl_tracer(): error initializing spline for ba(z)\n");
@@ -540,17 +515,19 @@ static CCL_ClTracer *cl_tracer(ccl_cosmology *cosmo,int tracer_type,
       }
     }
   }
-  else if(tracer_type==CL_TRACER_CL) {
-    clt->chi_source=ccl_comoving_radial_distance(cosmo,1./(1+z_source),status);
-    clt->chimax=clt->chi_source;
-    clt->chimin=0;
-  }
-  else {
+  else if(tracer_type!=CL_TRACER_CL) {
+    ccl_cl_tracer_free(clt);
     *status=CCL_ERROR_INCONSISTENT;
     ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer(): unknown tracer type\n");
     return NULL;
   }
 
+  cl_tracer_bind(cosmo,clt,status);
+  if(*status) {
+    ccl_cl_tracer_free(clt);
+    return NULL;
+  }
+
   return clt;
 }
 
@@ -581,33 +558,51 @@ CCL_ClTracer *ccl_cl_tracer(ccl_cosmology *cosmo,int tracer_type,
   return clt;
 }
 
-//CCL_ClTracer destructor
-void ccl_cl_tracer_free(CCL_ClTracer *clt)
+//Recomputes the cosmology-dependent quantities of an existing tracer
+//cosmo -> ccl_cosmology object
+//clt   -> tracer to update
+void ccl_cl_tracer_rebind(ccl_cosmology *cosmo,CCL_ClTracer *clt,int *status)
 {
-  if((clt->tracer_type==CL_TRACER_NC) || (clt->tracer_type==CL_TRACER_WL))
-    ccl_spline_free(clt->spl_nz);
+  cl_tracer_bind(cosmo,clt,status);
+  ccl_check_status(cosmo,status);
+}
 
-  if(clt->tracer_type==CL_TRACER_NC) {
-    ccl_spline_free(clt->spl_bz);
-    if(clt->has_magnification) {
-      ccl_spline_free(clt->spl_sz);
-      ccl_spline_free(clt->spl_wM);
-    }
+//Sets the photo-z shift and stretch of the N(z) of a tracer and updates the
+//quantities that depend on it
+//cosmo   -> ccl_cosmology object
+//clt     -> tracer to update
+//dz      -> shift in the mean redshift
+//stretch -> stretch factor of the width of N(z) around its mean
+void ccl_cl_tracer_set_photoz(ccl_cosmology *cosmo,CCL_ClTracer *clt,
+			      double dz,double stretch,int *status)
+{
+  if((clt->tracer_type!=CL_TRACER_NC) && (clt->tracer_type!=CL_TRACER_WL)) {
+    *status=CCL_ERROR_INCONSISTENT;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer_set_photoz(): tracer has no redshift distribution\n");
   }
-  else if(clt->tracer_type==CL_TRACER_WL) {
-    ccl_spline_free(clt->spl_wL);
-    if(clt->has_intrinsic_alignment) {
-      ccl_spline_free(clt->spl_ba);
-      ccl_spline_free(clt->spl_rf);
-    }
+  else if(stretch<=0) {
+    *status=CCL_ERROR_INCONSISTENT;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_tracer_set_photoz(): stretch must be positive\n");
   }
-  if(clt->computed_transfer) {
-    int il;
-    free(clt->n_k);
-    for(il=0;il<clt->n_ls;il++)
-      ccl_spline_free(clt->spl_transfer[il]);
-    free(clt->spl_transfer);
+  else {
+    clt->nz_shift=dz;
+    clt->nz_stretch=stretch;
+    cl_tracer_bind(cosmo,clt,status);
   }
+  ccl_check_status(cosmo,status);
+}
+
+//CCL_ClTracer destructor
+void ccl_cl_tracer_free(CCL_ClTracer *clt)
+{
+  ccl_spline_free(clt->spl_nz);
+  ccl_spline_free(clt->spl_bz);
+  ccl_spline_free(clt->spl_sz);
+  ccl_spline_free(clt->spl_wM);
+  ccl_spline_free(clt->spl_wL);
+  ccl_spline_free(clt->spl_ba);
+  ccl_spline_free(clt->spl_rf);
+  cl_tracer_free_transfer(clt);
   free(clt);
 }
 
@@ -670,6 +665,14 @@ static void limits_bessel(double l,double thr,double *xmin,double *xmax)
   }
 }
 
+//Spherical Bessel function, from a table if available
+static double j_bessel(const ccl_bessel_table *jl_tab,int l,double x)
+{
+  if(jl_tab!=NULL)
+    return ccl_bessel_table_eval(jl_tab,l,x);
+  return ccl_j_bessel(l,x);
+}
+
 static double j_bessel_limber(int l,double k)
 {
   return sqrt(M_PI/(2*l+1.))/k;
@@ -677,9 +680,15 @@ static double j_bessel_limber(int l,double k)
 
 static double f_dens(double a,ccl_cosmology *cosmo,CCL_ClTracer *clt, int * status)
 {
+  if(!clt->has_density)
+    return 0;
   double z=1./a-1;
-  double pz=ccl_spline_eval(z,clt->spl_nz);
-  double bz=ccl_spline_eval(z,clt->spl_bz);
+  double pz=cl_tracer_nz(clt,z);
+  double bz;
+  if(clt->spl_bz==NULL) //Bias template: unit bias in [bz_zmin,bz_zmax)
+    bz=((z>=clt->bz_zmin) && (z<clt->bz_zmax)) ? 1 : 0;
+  else
+    bz=ccl_spline_eval(z,clt->spl_bz);
   double h=cosmo->params.h*ccl_h_over_h0(cosmo,a,status)/CLIGHT_HMPC;
 
   return pz*bz*h;
@@ -688,7 +697,7 @@ static double f_dens(double a,ccl_cosmology *cosmo,CCL_ClTracer *clt, int * stat
 static double f_rsd(double a,ccl_cosmology *cosmo,CCL_ClTracer *clt, int * status)
 {
   double z=1./a-1;
-  double pz=ccl_spline_eval(z,clt->spl_nz);
+  double pz=cl_tracer_nz(clt,z);
   double fg=ccl_growth_rate(cosmo,a,status);
   double h=cosmo->params.h*ccl_h_over_h0(cosmo,a,status)/CLIGHT_HMPC;
 
@@ -705,14 +714,108 @@ static double f_mag(double a,double chi,ccl_cosmology *cosmo,CCL_ClTracer *clt,
     return wM/(a*chi);
 }
 
+static double f_lensing(double a,double chi,ccl_cosmology *cosmo,CCL_ClTracer *clt, int * status)
+{
+  double wL=ccl_spline_eval(chi,clt->spl_wL);
+
+  if(wL<=0)
+    return 0;
+  else
+    return clt->prefac_lensing*wL/(a*chi);
+}
+
+static double f_IA_NLA(double a,double chi,ccl_cosmology *cosmo,CCL_ClTracer *clt, int * status)
+{
+  if(chi<=1E-10)
+    return 0;
+  else {
+    double a=ccl_scale_factor_of_chi(cosmo,chi, status);
+    double z=1./a-1;
+    double pz=cl_tracer_nz(clt,z);
+    double ba=ccl_spline_eval(z,clt->spl_ba);
+    double rf=ccl_spline_eval(z,clt->spl_rf);
+    double h=cosmo->params.h*ccl_h_over_h0(cosmo,a,status)/CLIGHT_HMPC;
+
+    return pz*ba*rf*h/(chi*chi);
+  }
+}
+
+
+//Quantities of a tracer on the chi grid of the native non-Limber integrals.
+//They only depend on chi, so they are computed once and shared by all multipoles
+//and wavenumbers (see transfer_chi_cache_init).
+typedef struct {
+  int nchi; //Number of nodes
+  double *chi; //Nodes, at chimin+dchi*(i+0.5)
+  double *a; //Scale factor at the nodes
+  double *f_j; //Factor multiplying j_l (density for number counts, lensing and IA for shear)
+  double *f_rsd; //Factor multiplying the RSD term (NULL if the tracer has no RSD)
+  double *f_mag; //Factor multiplying the magnification term (NULL if the tracer has no magnification)
+} TransferChiCache;
+
+//Fill the chi grid of the native non-Limber integrals and the radial factors of a tracer on it.
+//The arrays share a single allocation, which is freed by transfer_chi_cache_free.
+static void transfer_chi_cache_init(ccl_cosmology *cosmo,CCL_ClWorkspace *w,CCL_ClTracer *clt,
+				    TransferChiCache *cache,int *status)
+{
+  int i,nchi=(int)((clt->chimax-clt->chimin)/w->dchi)+1;
+  while((nchi>0) && (clt->chimin+w->dchi*(nchi-0.5)>clt->chimax))
+    nchi--;
+  int has_rsd=(clt->tracer_type==CL_TRACER_NC) && clt->has_rsd;
+  int has_mag=(clt->tracer_type==CL_TRACER_NC) && clt->has_magnification;
+
+  cache->nchi=nchi;
+  cache->chi=(double *)malloc(CCL_MAX(5*nchi,1)*sizeof(double));
+  if(cache->chi==NULL) {
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: transfer_chi_cache_init(): memory allocation\n");
+    return;
+  }
+  cache->a=cache->chi+nchi;
+  cache->f_j=cache->chi+2*nchi;
+  cache->f_rsd=has_rsd ? cache->chi+3*nchi : NULL;
+  cache->f_mag=has_mag ? cache->chi+4*nchi : NULL;
+
+  for(i=0;i<nchi;i++)
+    cache->chi[i]=clt->chimin+w->dchi*(i+0.5);
+  ccl_scale_factor_of_chis(cosmo,nchi,cache->chi,cache->a,status);
+  for(i=0;i<nchi;i++) {
+    double a=cache->a[i],chi=cache->chi[i];
+    if(clt->tracer_type==CL_TRACER_NC) {
+      cache->f_j[i]=f_dens(a,cosmo,clt,status);
+      if(has_rsd)
+	cache->f_rsd[i]=f_rsd(a,cosmo,clt,status);
+      if(has_mag)
+	cache->f_mag[i]=f_mag(a,chi,cosmo,clt,status);
+    }
+    else {
+      cache->f_j[i]=f_lensing(a,chi,cosmo,clt,status);
+      if(clt->has_intrinsic_alignment)
+	cache->f_j[i]+=f_IA_NLA(a,chi,cosmo,clt,status);
+    }
+  }
+}
+
+static void transfer_chi_cache_free(TransferChiCache *cache)
+{
+  free(cache->chi);
+  cache->chi=NULL;
+}
+
 //Transfer function for number counts
 //l -> angular multipole
 //k -> wavenumber modulus
 //cosmo -> ccl_cosmology object
 //w -> CCL_ClWorskpace object
 //clt -> CCL_ClTracer object (must be of the CL_TRACER_NC type)
+//Beyond Limber's approximation:
+//cache -> radial factors of the tracer
+//sqpk -> sqrt(P(k,a)) at the nodes of cache
+//jl_tab -> table of j_l and j_{l+1} (can be NULL)
 static double transfer_nc(int l,double k,
-			  ccl_cosmology *cosmo,CCL_ClWorkspace *w,CCL_ClTracer *clt, int * status)
+			  ccl_cosmology *cosmo,CCL_ClWorkspace *w,CCL_ClTracer *clt,
+			  const TransferChiCache *cache,const double *sqpk,
+			  const ccl_bessel_table *jl_tab,int * status)
 {
   double ret=0;
   if(l>w->l_limber) {
@@ -741,32 +844,29 @@ static double transfer_nc(int l,double k,
     }
   }
   else {
-    int i,nchi=(int)((clt->chimax-clt->chimin)/w->dchi)+1;
-    for(i=0;i<nchi;i++) {
-      double chi=clt->chimin+w->dchi*(i+0.5);
-      if(chi<=clt->chimax) {
-	double a=ccl_scale_factor_of_chi(cosmo,chi,status);
-	double pk=ccl_nonlin_matter_power(cosmo,k,a,status);
-	double jl=ccl_j_bessel(l,k*chi);
-	double f_all=f_dens(a,cosmo,clt,status)*jl;
-	if(clt->has_rsd) {
-	  double ddjl,x=k*chi;
-	  if(x<1E-10) {
-	    if(l==0) ddjl=0.3333-0.1*x*x;
-	    else if(l==2) ddjl=-0.13333333333+0.05714285714285714*x*x;
-	    else ddjl=0;
-          }
-	  else {
-	    double jlp1=ccl_j_bessel(l+1,x);
-	    ddjl=((x*x-l*(l-1))*jl-2*x*jlp1)/(x*x);
-	  }
-	  f_all+=f_rsd(a,cosmo,clt,status)*ddjl;
+    int i;
+    double c_mag=-2*clt->prefac_lensing*l*(l+1)/(k*k);
+    for(i=0;i<cache->nchi;i++) {
+      double x=k*cache->chi[i];
+      double jl=j_bessel(jl_tab,l,x);
+      double f_all=cache->f_j[i];
+      if(cache->f_mag!=NULL)
+	f_all+=c_mag*cache->f_mag[i];
+      f_all*=jl;
+      if(cache->f_rsd!=NULL) {
+	double ddjl;
+	if(x<1E-10) {
+	  if(l==0) ddjl=0.3333-0.1*x*x;
+	  else if(l==2) ddjl=-0.13333333333+0.05714285714285714*x*x;
+	  else ddjl=0;
 	}
-	if(clt->has_magnification)
-	  f_all+=-2*clt->prefac_lensing*l*(l+1)*f_mag(a,chi,cosmo,clt,status)*jl/(k*k);
-
-	ret+=f_all*sqrt(pk); //TODO: is it worth splining this sqrt?
+	else {
+	  double jlp1=j_bessel(jl_tab,l+1,x);
+	  ddjl=((x*x-l*(l-1))*jl-2*x*jlp1)/(x*x);
+	}
+	f_all+=cache->f_rsd[i]*ddjl;
       }
+      ret+=f_all*sqpk[i];
     }
     ret*=w->dchi;
   }
@@ -774,41 +874,20 @@ static double transfer_nc(int l,double k,
   return ret;
 }
 
-static double f_lensing(double a,double chi,ccl_cosmology *cosmo,CCL_ClTracer *clt, int * status)
-{
-  double wL=ccl_spline_eval(chi,clt->spl_wL);
-
-  if(wL<=0)
-    return 0;
-  else
-    return clt->prefac_lensing*wL/(a*chi);
-}
-
-static double f_IA_NLA(double a,double chi,ccl_cosmology *cosmo,CCL_ClTracer *clt, int * status)
-{
-  if(chi<=1E-10)
-    return 0;
-  else {
-    double a=ccl_scale_factor_of_chi(cosmo,chi, status);
-    double z=1./a-1;
-    double pz=ccl_spline_eval(z,clt->spl_nz);
-    double ba=ccl_spline_eval(z,clt->spl_ba);
-    double rf=ccl_spline_eval(z,clt->spl_rf);
-    double h=cosmo->params.h*ccl_h_over_h0(cosmo,a,status)/CLIGHT_HMPC;
-
-    return pz*ba*rf*h/(chi*chi);
-  }
-}
-
-
 //Transfer function for shear
 //l -> angular multipole
 //k -> wavenumber modulus
 //cosmo -> ccl_cosmology object
 //w -> CCL_ClWorskpace object
 //clt -> CCL_ClTracer object (must be of the CL_TRACER_WL type)
+//Beyond Limber's approximation:
+//cache -> radial factors of the tracer
+//sqpk -> sqrt(P(k,a)) at the nodes of cache
+//jl_tab -> table of j_l (can be NULL)
 static double transfer_wl(int l,double k,
-			  ccl_cosmology *cosmo,CCL_ClWorkspace *w,CCL_ClTracer *clt, int * status)
+			  ccl_cosmology *cosmo,CCL_ClWorkspace *w,CCL_ClTracer *clt,
+			  const TransferChiCache *cache,const double *sqpk,
+			  const ccl_bessel_table *jl_tab,int * status)
 {
   double ret=0;
   if(l>w->l_limber) {
@@ -825,20 +904,9 @@ static double transfer_wl(int l,double k,
     }
   }
   else {
-    int i,nchi=(int)((clt->chimax-clt->chimin)/w->dchi)+1;
-    for(i=0;i<nchi;i++) {
-      double chi=clt->chimin+w->dchi*(i+0.5);
-      if(chi<=clt->chimax) {
-	double a=ccl_scale_factor_of_chi(cosmo,chi,status);
-	double pk=ccl_nonlin_matter_power(cosmo,k,a,status);
-	double jl=ccl_j_bessel(l,k*chi);
-	double f_all=f_lensing(a,chi,cosmo,clt,status)*jl;
-	if(clt->has_intrinsic_alignment)
-	  f_all+=f_IA_NLA(a,chi,cosmo,clt,status)*jl;
-
-	ret+=f_all*sqrt(pk); //TODO: is it worth splining this sqrt?
-      }
-    }
+    int i;
+    for(i=0;i<cache->nchi;i++)
+      ret+=cache->f_j[i]*j_bessel(jl_tab,l,k*cache->chi[i])*sqpk[i];
     ret*=w->dchi;
   }
 
@@ -867,16 +935,22 @@ static double transfer_cmblens(int l,double k,ccl_cosmology *cosmo,CCL_ClTracer
 //k -> wavenumber modulus
 //cosmo -> ccl_cosmology object
 //clt -> CCL_ClTracer object
+//Only needed beyond Limber's approximation:
+//cache -> radial factors of the tracer
+//sqpk -> sqrt(P(k,a)) at the nodes of cache
+//jl_tab -> table of spherical Bessel functions for this multipole (can be NULL)
 static double transfer_wrap(int il,double lk,ccl_cosmology *cosmo,
-			    CCL_ClWorkspace *w,CCL_ClTracer *clt, int * status)
+			    CCL_ClWorkspace *w,CCL_ClTracer *clt,
+			    const TransferChiCache *cache,const double *sqpk,
+			    const ccl_bessel_table *jl_tab,int * status)
 {
   double transfer_out=0;
   double k=pow(10.,lk);
 
   if(clt->tracer_type==CL_TRACER_NC)
-    transfer_out=transfer_nc(w->l_arr[il],k,cosmo,w,clt,status);
+    transfer_out=transfer_nc(w->l_arr[il],k,cosmo,w,clt,cache,sqpk,jl_tab,status);
   else if(clt->tracer_type==CL_TRACER_WL)
-    transfer_out=transfer_wl(w->l_arr[il],k,cosmo,w,clt,status);
+    transfer_out=transfer_wl(w->l_arr[il],k,cosmo,w,clt,cache,sqpk,jl_tab,status);
   else if(clt->tracer_type==CL_TRACER_CL)
     transfer_out=transfer_cmblens(w->l_arr[il],k,cosmo,clt,status);
   else
@@ -884,6 +958,13 @@ static double transfer_wrap(int il,double lk,ccl_cosmology *cosmo,
   return transfer_out;
 }
 
+//Spacing in x of the tables of spherical Bessel functions used beyond Limber's
+//approximation. Interpolation errors are ~1E-6, below the accuracy of ccl_j_bessel.
+#define CCL_BESSEL_TABLE_DX 0.2
+//Maximum number of nodes of a Bessel table. Arguments beyond the table are
+//computed directly.
+#define CCL_BESSEL_TABLE_NMAX 65536
+
 static double *get_lkarr(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
 			 double l,double chimin,double chimax,int *nk,
 			 int *status)
@@ -948,32 +1029,508 @@ static double *get_lkarr(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
   return lkarr;
 }
 
-static void compute_transfer(CCL_ClTracer *clt,ccl_cosmology *cosmo,CCL_ClWorkspace *w,int *status)
+//Padding factor of the chi grid used by CCL_NONLIMBER_METHOD_FFTLOG on both ends of the
+//range needed. It keeps the wavenumbers where the transfer functions are used away from
+//the edges of the (periodic) discrete transforms.
+#define CCL_FFTLOG_CHI_PAD 4.
+
+//Adds the spherical Bessel transform of f to out:
+//out(k) += \int dchi f(chi) j_l(k*chi)
+//n -> number of nodes (a power of 2 is fastest)
+//chi -> logarithmically-spaced nodes in chi
+//kcrc -> product of the central nodes in k and chi. The output nodes in k only depend on it,
+//        so all orders transformed with the same kcrc share them.
+//k -> output nodes in k
+//Returns 0 on success and 1 if memory couldn't be allocated.
+static int fftlog_transform_jl(int n,double *chi,double *f,int l,double kcrc,
+			       double *k,double *out)
 {
-  int il;
-  double zmin=CCL_MAX(w->zmin,clt->zmin);
-  double chimin=ccl_comoving_radial_distance(cosmo,1./(1+zmin),status);
-  double chimax=clt->chimax;
+  int i;
+  //Bias by (k*chi)^-1, so that kernels that don't vanish at chi->0 (lensing) don't ring.
+  //Transforms of order 0 are more accurate unbiased.
+  double q=(l==0) ? 0 : -1;
+  double complex *a=malloc(n*sizeof(double complex));
+  double complex *b=malloc(n*sizeof(double complex));
+  if((a==NULL) || (b==NULL)) {
+    free(a);
+    free(b);
+    return 1;
+  }
 
-  //Get how many multipoles and allocate info for each of them
-  clt->n_ls=w->n_ls;
-  clt->n_k=(int *)malloc(clt->n_ls*sizeof(int));
-  if(clt->n_k==NULL) {
+  for(i=0;i<n;i++)
+    a[i]=f[i]*pow(chi[i],-0.5-q);
+  fht(n,chi,a,k,b,l+0.5,q,kcrc,0,NULL);
+  for(i=0;i<n;i++)
+    out[i]+=sqrt(0.5*M_PI)*pow(k[i],-1.5-q)*creal(b[i]);
+
+  free(a);
+  free(b);
+  return 0;
+}
+
+//Transfer function beyond Limber's approximation computed with FFTLog
+//(CCL_NONLIMBER_METHOD_FFTLOG). The integrals over chi are spherical Bessel
+//transforms of the radial kernels, computed for all k at once. To separate
+//them, the power spectrum is factorized as P(k,chi)=P(k,chi_eff)*[D(chi)/D(chi_eff)]^2,
+//where D is the growth factor and chi_eff the mean distance weighted by the kernels.
+//This is exact for linear power spectra with scale-independent growth. For nonlinear
+//power spectra it is only an approximation, meant for narrow kernels (clustering bins);
+//broad lensing and magnification kernels should use the Levin or native methods.
+//The RSD term is decomposed into j_{l-2}, j_l and j_{l+2}.
+//l -> angular multipole
+//nk, lkarr -> nodes in log10(k) where the transfer function is needed
+//tkarr -> output transfer function
+static void transfer_fftlog(ccl_cosmology *cosmo,CCL_ClWorkspace *w,CCL_ClTracer *clt,
+			    int l,int nk,double *lkarr,double *tkarr,int *status)
+{
+  int i,ik,n;
+  double kcrc=l+0.5;
+
+  //The chi grid must cover the kernels and all k nodes, with k*chi~kcrc
+  double chi_lo=kcrc/pow(10.,lkarr[nk-1]);
+  double chi_hi=CCL_MAX(clt->chimax,kcrc/pow(10.,lkarr[0]))*CCL_FFTLOG_CHI_PAD;
+  if(clt->chimin>0)
+    chi_lo=CCL_MIN(chi_lo,clt->chimin);
+  chi_lo/=CCL_FFTLOG_CHI_PAD;
+  //At the far end of the kernels, sample chi at least as finely as the native method
+  int n_min=(int)(log(chi_hi/chi_lo)*clt->chimax/w->dchi)+1;
+  for(n=2;n<n_min;n*=2);
+  double dlchi=log(chi_hi/chi_lo)/(n-1.);
+
+  //chi, k, log10(k), transfer and the radial kernels for j_l, j_{l-2}, j_{l+2} and magnification
+  double *buf=(double *)calloc(8*n,sizeof(double));
+  if(buf==NULL) {
     *status=CCL_ERROR_MEMORY;
-    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: compute_transfer(): memory allocation\n");
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: transfer_fftlog(): memory allocation\n");
     return;
   }
-  clt->spl_transfer=(SplPar **)malloc(clt->n_ls*sizeof(SplPar *));
-  if(clt->spl_transfer==NULL) {
-    free(clt->n_k);
-    *status=CCL_ERROR_MEMORY;
-    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: compute_transfer(): memory allocation\n");
+  double *chi_arr=buf,*k_arr=buf+n,*lk_arr=buf+2*n,*t_arr=buf+3*n;
+  double *f_l=buf+4*n,*f_lm2=buf+5*n,*f_lp2=buf+6*n,*f_m=buf+7*n;
+  int has_rsd=(clt->tracer_type==CL_TRACER_NC) && clt->has_rsd;
+  int has_mag=(clt->tracer_type==CL_TRACER_NC) && clt->has_magnification;
+
+  //Coefficients of j_{l-2}, j_l and j_{l+2} in the second derivative of j_l
+  double c_lm2=l*(l-1.)/((2*l-1.)*(2*l+1.));
+  double c_l=(2.*l*l+2*l-1.)/((2*l-1.)*(2*l+3.));
+  double c_lp2=(l+1.)*(l+2.)/((2*l+1.)*(2*l+3.));
+
+  //Radial kernels, including the growth factor
+  double sum_w=0,sum_wchi=0;
+  for(i=0;i<n;i++) {
+    double chi=chi_lo*exp(i*dlchi);
+    chi_arr[i]=chi;
+    if((chi<clt->chimin) || (chi>clt->chimax))
+      continue;
+    double a=ccl_scale_factor_of_chi(cosmo,chi,status);
+    double gf=ccl_growth_factor(cosmo,a,status);
+    if(clt->tracer_type==CL_TRACER_NC) {
+      f_l[i]=f_dens(a,cosmo,clt,status)*gf;
+      if(has_rsd) {
+	double fr=f_rsd(a,cosmo,clt,status)*gf;
+	f_l[i]+=c_l*fr;
+	f_lm2[i]=-c_lm2*fr;
+	f_lp2[i]=-c_lp2*fr;
+      }
+      if(has_mag)
+	f_m[i]=f_mag(a,chi,cosmo,clt,status)*gf;
+    }
+    else {
+      f_l[i]=f_lensing(a,chi,cosmo,clt,status);
+      if(clt->has_intrinsic_alignment)
+	f_l[i]+=f_IA_NLA(a,chi,cosmo,clt,status);
+      f_l[i]*=gf;
+    }
+    //Weights for chi_eff (d chi = chi * dlchi). The magnification term is weighted
+    //at k~kcrc/chi, where it peaks.
+    double wgt=(fabs(f_l[i])+fabs(f_lm2[i])+fabs(f_lp2[i])+
+		2*clt->prefac_lensing*fabs(f_m[i])*chi*chi)*chi;
+    sum_w+=wgt;
+    sum_wchi+=wgt*chi;
+  }
+  if(*status) {
+    free(buf);
+    return;
+  }
+  if(sum_w<=0) {
+    for(ik=0;ik<nk;ik++)
+      tkarr[ik]=0;
+    free(buf);
     return;
   }
 
-  //Loop over multipoles and compute transfer function for each
-  for(il=0;il<clt->n_ls;il++) {
+  //Transform all terms to a common grid in k
+  int memstatus=fftlog_transform_jl(n,chi_arr,f_l,l,kcrc,k_arr,t_arr);
+  if(has_rsd) {
+    if(l>=2)
+      memstatus|=fftlog_transform_jl(n,chi_arr,f_lm2,l-2,kcrc,k_arr,t_arr);
+    memstatus|=fftlog_transform_jl(n,chi_arr,f_lp2,l+2,kcrc,k_arr,t_arr);
+  }
+  if(has_mag) {
+    //Only the magnification kernel is needed from now on, so transform it in place
+    double *t_m=f_lm2;
+    for(i=0;i<n;i++)
+      t_m[i]=0;
+    memstatus|=fftlog_transform_jl(n,chi_arr,f_m,l,kcrc,k_arr,t_m);
+    for(i=0;i<n;i++)
+      t_arr[i]+=-2*clt->prefac_lensing*l*(l+1.)*t_m[i]/(k_arr[i]*k_arr[i]);
+  }
+  if(memstatus) {
+    free(buf);
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: transfer_fftlog(): memory allocation\n");
+    return;
+  }
+  if(clt->tracer_type==CL_TRACER_WL) {
+    for(i=0;i<n;i++)
+      t_arr[i]*=sqrt((l+2.)*(l+1.)*l*(l-1.))/(k_arr[i]*k_arr[i]);
+  }
+
+  //Interpolate into the k nodes and multiply by the power spectrum at chi_eff
+  for(i=0;i<n;i++)
+    lk_arr[i]=log10(k_arr[i]);
+  SplPar *spl_t=ccl_spline_init(n,lk_arr,t_arr,0,0);
+  if(spl_t==NULL) {
+    free(buf);
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: transfer_fftlog(): memory allocation\n");
+    return;
+  }
+  double a_eff=ccl_scale_factor_of_chi(cosmo,sum_wchi/sum_w,status);
+  double gf_eff=ccl_growth_factor(cosmo,a_eff,status);
+  for(ik=0;ik<nk;ik++) {
+    double pk=ccl_nonlin_matter_power(cosmo,pow(10.,lkarr[ik]),a_eff,status);
+    tkarr[ik]=ccl_spline_eval(lkarr[ik],spl_t)*sqrt(pk)/gf_eff;
+  }
+  ccl_spline_free(spl_t);
+  free(buf);
+}
+
+//Number of Chebyshev nodes used by CCL_NONLIMBER_METHOD_LEVIN in each interval in chi
+#define CCL_LEVIN_NCOL 8
+//Number of intervals each segment of the support of the kernels is initially split into
+#define CCL_LEVIN_NSPLIT 4
+//Maximum number of bisections of each initial interval
+#define CCL_LEVIN_MAX_DEPTH 12
+
+//Parameters of the Levin integrals of a tracer at fixed multipole and wavenumber
+typedef struct {
+  ccl_cosmology *cosmo;
+  CCL_ClTracer *clt;
+  int l;
+  double k;
+  double c_mag; //Prefactor of the magnification term
+  gsl_matrix *mat; //Collocation matrix (2*CCL_LEVIN_NCOL x 2*CCL_LEVIN_NCOL)
+  gsl_vector *vec; //Collocation right-hand side, overwritten with the solution
+  gsl_permutation *perm;
+  int *status;
+} LevinPar;
+
+//Radial kernels multiplying j_l(k*chi) (f0) and j_{l+1}(k*chi) (f1) in the transfer function,
+//including sqrt(P(k,a)). The RSD term uses j_l''(x)=(1-l(l-1)/x^2)*j_l(x)-2*j_{l+1}(x)/x.
+static void levin_kernel(LevinPar *p,double chi,double *f0,double *f1)
+{
+  ccl_cosmology *cosmo=p->cosmo;
+  CCL_ClTracer *clt=p->clt;
+  double a=ccl_scale_factor_of_chi(cosmo,chi,p->status);
+  double sqpk=sqrt(ccl_nonlin_matter_power(cosmo,p->k,a,p->status));
+
+  *f1=0;
+  if(clt->tracer_type==CL_TRACER_NC) {
+    *f0=f_dens(a,cosmo,clt,p->status);
+    if(clt->has_magnification)
+      *f0+=p->c_mag*f_mag(a,chi,cosmo,clt,p->status);
+    if(clt->has_rsd) {
+      double x=p->k*chi;
+      double fr=f_rsd(a,cosmo,clt,p->status);
+      *f0+=fr*(1-p->l*(p->l-1.)/(x*x));
+      *f1=-2*fr/x;
+    }
+  }
+  else if(clt->tracer_type==CL_TRACER_WL) {
+    *f0=f_lensing(a,chi,cosmo,clt,p->status);
+    if(clt->has_intrinsic_alignment)
+      *f0+=f_IA_NLA(a,chi,cosmo,clt,p->status);
+  }
+  else
+    *f0=clt->prefac_lensing*(1-chi/clt->chi_source)/(a*chi);
+  *f0*=sqpk;
+  *f1*=sqpk;
+}
+
+//Integral of f0(chi)*j_l(k*chi)+f1(chi)*j_{l+1}(k*chi) over [chi_a,chi_b] with Levin's method.
+//w=(j_l,j_{l+1}) satisfies w'=A*w, with A=[[l/chi,-k],[k,-(l+2)/chi]], so the integral is
+//p.w(chi_b)-p.w(chi_a) for any p solving p'+A^T*p=(f0,f1). p is non-oscillatory, so it is
+//expanded in Chebyshev polynomials and the equation is solved at CCL_LEVIN_NCOL Chebyshev nodes.
+static double levin_integral(LevinPar *p,double chi_a,double chi_b)
+{
+  int i,m,n=CCL_LEVIN_NCOL;
+  double t_arr[CCL_LEVIN_NCOL],dt_arr[CCL_LEVIN_NCOL];
+  double hw=0.5*(chi_b-chi_a),chi_c=0.5*(chi_a+chi_b);
+
+  for(i=0;i<n;i++) {
+    double t=cos(M_PI*i/(n-1.));
+    double chi=chi_c+hw*t;
+    double f0,f1;
+    levin_kernel(p,chi,&f0,&f1);
+
+    //Chebyshev polynomials and their derivatives at t
+    t_arr[0]=1; dt_arr[0]=0;
+    t_arr[1]=t; dt_arr[1]=1;
+    for(m=2;m<n;m++) {
+      t_arr[m]=2*t*t_arr[m-1]-t_arr[m-2];
+      dt_arr[m]=2*t_arr[m-1]+2*t*dt_arr[m-1]-dt_arr[m-2];
+    }
+    for(m=0;m<n;m++) {
+      double u=t_arr[m],du=dt_arr[m]/hw;
+      gsl_matrix_set(p->mat,i,m,du+p->l*u/chi);
+      gsl_matrix_set(p->mat,i,n+m,p->k*u);
+      gsl_matrix_set(p->mat,n+i,m,-p->k*u);
+      gsl_matrix_set(p->mat,n+i,n+m,du-(p->l+2.)*u/chi);
+    }
+    gsl_vector_set(p->vec,i,f0);
+    gsl_vector_set(p->vec,n+i,f1);
+  }
+
+  int sgn,gslstatus=gsl_linalg_LU_decomp(p->mat,p->perm,&sgn);
+  if(gslstatus==GSL_SUCCESS)
+    gslstatus=gsl_linalg_LU_svx(p->mat,p->perm,p->vec);
+  if(gslstatus!=GSL_SUCCESS) {
+    ccl_raise_gsl_warning(gslstatus, "ccl_cls.c: levin_integral():");
+    *(p->status)=CCL_ERROR_INTEG;
+    return 0;
+  }
+
+  //p at the ends of the interval (t=-1 and t=1)
+  double pa0=0,pa1=0,pb0=0,pb1=0;
+  for(m=0;m<n;m++) {
+    double s=(m%2) ? -1 : 1;
+    pa0+=s*gsl_vector_get(p->vec,m);
+    pa1+=s*gsl_vector_get(p->vec,n+m);
+    pb0+=gsl_vector_get(p->vec,m);
+    pb1+=gsl_vector_get(p->vec,n+m);
+  }
+
+  return pb0*ccl_j_bessel(p->l,p->k*chi_b)+pb1*ccl_j_bessel(p->l+1,p->k*chi_b)-
+    pa0*ccl_j_bessel(p->l,p->k*chi_a)-pa1*ccl_j_bessel(p->l+1,p->k*chi_a);
+}
+
+//Bisects [chi_a,chi_b] until the sum of the integrals over both halves agrees
+//with the integral over the whole interval (i_ab) within tol
+static double levin_adaptive(LevinPar *p,double chi_a,double chi_b,double i_ab,
+			     double tol,int depth)
+{
+  double chi_m=0.5*(chi_a+chi_b);
+  double i_am=levin_integral(p,chi_a,chi_m);
+  double i_mb=levin_integral(p,chi_m,chi_b);
+
+  if((fabs(i_am+i_mb-i_ab)<=tol) || (depth>=CCL_LEVIN_MAX_DEPTH) || *(p->status))
+    return i_am+i_mb;
+  return levin_adaptive(p,chi_a,chi_m,i_am,tol,depth+1)+
+    levin_adaptive(p,chi_m,chi_b,i_mb,tol,depth+1);
+}
+
+//Transfer function beyond Limber's approximation computed with Levin's method
+//(CCL_NONLIMBER_METHOD_LEVIN). The integral over chi is computed for each k
+//independently, starting from a few intervals covering the support of the kernels
+//(with the edges of N(z) as breakpoints) and bisecting them until the relative
+//accuracy reaches ccl_gsl->INTEGRATION_LIMBER_EPSREL. Distances where j_l is below
+//that fraction of its maximum are skipped.
+//l -> angular multipole
+//nk, lkarr -> nodes in log10(k) where the transfer function is needed
+//tkarr -> output transfer function
+static void transfer_levin(ccl_cosmology *cosmo,CCL_ClWorkspace *w,CCL_ClTracer *clt,
+			   int l,int nk,double *lkarr,double *tkarr,int *status)
+{
+  int ik,ib,is;
+  double eps=ccl_gsl->INTEGRATION_LIMBER_EPSREL;
+  LevinPar p;
+
+  //Lensing kernels vanish for l<2
+  if((clt->tracer_type==CL_TRACER_WL) && (l<2)) {
+    for(ik=0;ik<nk;ik++)
+      tkarr[ik]=0;
+    return;
+  }
+
+  p.cosmo=cosmo;
+  p.clt=clt;
+  p.l=l;
+  p.status=status;
+  p.mat=gsl_matrix_alloc(2*CCL_LEVIN_NCOL,2*CCL_LEVIN_NCOL);
+  p.vec=gsl_vector_alloc(2*CCL_LEVIN_NCOL);
+  p.perm=gsl_permutation_alloc(2*CCL_LEVIN_NCOL);
+  if((p.mat==NULL) || (p.vec==NULL) || (p.perm==NULL)) {
+    if(p.mat!=NULL) gsl_matrix_free(p.mat);
+    if(p.vec!=NULL) gsl_vector_free(p.vec);
+    if(p.perm!=NULL) gsl_permutation_free(p.perm);
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: transfer_levin(): memory allocation\n");
+    return;
+  }
+
+  //Breakpoints: the edges of the kernels and, if the kernels extend beyond it
+  //(magnification), the lower edge of N(z)
+  int nbrk=0;
+  double brk[3];
+  brk[nbrk++]=clt->chimin;
+  if(clt->tracer_type==CL_TRACER_NC) {
+    double chi_nz=ccl_comoving_radial_distance(cosmo,1./(1+cl_tracer_photoz_z(clt,clt->nz_zmin)),status);
+    if((chi_nz>clt->chimin) && (chi_nz<clt->chimax))
+      brk[nbrk++]=chi_nz;
+  }
+  brk[nbrk++]=clt->chimax;
+
+  double xmin,xmax;
+  limits_bessel(l,eps,&xmin,&xmax);
+
+  for(ik=0;(*status==0) && (ik<nk);ik++) {
+    double k=pow(10.,lkarr[ik]);
+    double chi_lo=CCL_MAX(clt->chimin,xmin/k);
+    //Keep away from chi=0, where the equation for p is singular. The kernels vanish there.
+    chi_lo=CCL_MAX(chi_lo,1E-5*clt->chimax);
+    p.k=k;
+    p.c_mag=-2*clt->prefac_lensing*l*(l+1.)/(k*k);
+
+    //Initial intervals and their integrals
+    int n_int=0;
+    double chi_int[2*CCL_LEVIN_NSPLIT+1],i_int[2*CCL_LEVIN_NSPLIT];
+    double i_sum=0;
+    chi_int[0]=chi_lo;
+    for(ib=0;ib<nbrk-1;ib++) {
+      double chi_a=CCL_MAX(brk[ib],chi_lo),chi_b=brk[ib+1];
+      if(chi_b<=chi_a)
+	continue;
+      for(is=0;is<CCL_LEVIN_NSPLIT;is++) {
+	chi_int[n_int+1]=chi_a+(chi_b-chi_a)*(is+1.)/CCL_LEVIN_NSPLIT;
+	i_int[n_int]=levin_integral(&p,chi_int[n_int],chi_int[n_int+1]);
+	i_sum+=fabs(i_int[n_int]);
+	n_int++;
+      }
+    }
+
+    //Refine each interval to a share of the total tolerance
+    double tk=0;
+    for(is=0;(*status==0) && (is<n_int);is++)
+      tk+=levin_adaptive(&p,chi_int[is],chi_int[is+1],i_int[is],eps*i_sum/n_int,0);
+    if(clt->tracer_type==CL_TRACER_WL)
+      tk*=sqrt((l+2.)*(l+1.)*l*(l-1.))/(k*k);
+    else if(clt->tracer_type==CL_TRACER_CL)
+      tk*=l*(l+1.)/(k*k);
+    tkarr[ik]=tk;
+  }
+  if(*status==CCL_ERROR_INTEG)
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: transfer_levin(): error solving the collocation system\n");
+
+  gsl_matrix_free(p.mat);
+  gsl_vector_free(p.vec);
+  gsl_permutation_free(p.perm);
+}
+
+//Size of the blocks of wavenumbers for which sqrt(P(k,a)) is tabulated at once
+//in the native non-Limber integrals
+#define CCL_TRANSFER_KBLOCK 32
+
+//Transfer function beyond Limber's approximation computed with the native method.
+//sqrt(P(k,a)) is tabulated at all the nodes of the chi grid for blocks of
+//CCL_TRANSFER_KBLOCK wavenumbers, evaluating the power spectrum at fixed a for the
+//whole block. The sums over chi then run over contiguous arrays.
+//il -> index of the multipole in the workspace
+//cache -> radial factors of the tracer
+//sqpk -> scratch space for CCL_TRANSFER_KBLOCK*cache->nchi values
+//nk, lkarr -> nodes in log10(k) where the transfer function is needed
+//tkarr -> output transfer function
+static void transfer_native(ccl_cosmology *cosmo,CCL_ClWorkspace *w,CCL_ClTracer *clt,int il,
+			    const TransferChiCache *cache,double *sqpk,
+			    int nk,double *lkarr,double *tkarr,int *status)
+{
+  int i,ib,ik0;
+  double kb[CCL_TRANSFER_KBLOCK],pkb[CCL_TRANSFER_KBLOCK];
+
+  //Tabulate the Bessel functions needed for all k. Each node costs two calls to
+  //ccl_j_bessel, so the table is capped at half the number of evaluations it serves
+  //(and at CCL_BESSEL_TABLE_NMAX nodes). Larger arguments are computed directly.
+  int nl_tab=((clt->tracer_type==CL_TRACER_NC) && clt->has_rsd) ? 2 : 1;
+  double nx_tab=CCL_MIN(0.5*nl_tab*nk*(double)(cache->nchi),CCL_BESSEL_TABLE_NMAX);
+  double xmax=CCL_MIN(pow(10.,lkarr[nk-1])*clt->chimax,nx_tab*CCL_BESSEL_TABLE_DX);
+  ccl_bessel_table *jl_tab=ccl_bessel_table_new(w->l_arr[il],nl_tab,xmax,CCL_BESSEL_TABLE_DX);
+
+  for(ik0=0;ik0<nk;ik0+=CCL_TRANSFER_KBLOCK) {
+    int nb=CCL_MIN(CCL_TRANSFER_KBLOCK,nk-ik0);
+    for(ib=0;ib<nb;ib++)
+      kb[ib]=pow(10.,lkarr[ik0+ib]);
+    //Stored contiguously in chi for each k
+    for(i=0;i<cache->nchi;i++) {
+      ccl_nonlin_matter_powers_at_a(cosmo,cache->a[i],nb,kb,pkb,status);
+      for(ib=0;ib<nb;ib++)
+	sqpk[ib*cache->nchi+i]=sqrt(pkb[ib]);
+    }
+    for(ib=0;ib<nb;ib++)
+      tkarr[ik0+ib]=transfer_wrap(il,lkarr[ik0+ib],cosmo,w,clt,
+				  cache,&(sqpk[ib*cache->nchi]),jl_tab,status);
+  }
+  ccl_bessel_table_free(jl_tab);
+}
+
+//Computes the transfer functions of a tracer beyond Limber's approximation.
+//The splines are allocated for all the multipoles of the workspace the first time this is
+//called, but only the multipoles flagged in todo (all of them if todo is NULL) that are not
+//yet available are computed. Multipoles above l_limber never use them and are skipped.
+static void compute_transfer(CCL_ClTracer *clt,ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+			     int method,const int *todo,int *status)
+{
+  int il;
+  double zmin=CCL_MAX(w->zmin,clt->zmin);
+  double chimin=ccl_comoving_radial_distance(cosmo,1./(1+zmin),status);
+  double chimax=clt->chimax;
+
+  //Get how many multipoles and allocate info for each of them
+  if(!(clt->computed_transfer)) {
+    clt->n_ls=w->n_ls;
+    clt->n_k=(int *)calloc(clt->n_ls,sizeof(int));
+    if(clt->n_k==NULL) {
+      *status=CCL_ERROR_MEMORY;
+      ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: compute_transfer(): memory allocation\n");
+      return;
+    }
+    clt->spl_transfer=(SplPar **)calloc(clt->n_ls,sizeof(SplPar *));
+    if(clt->spl_transfer==NULL) {
+      free(clt->n_k);
+      *status=CCL_ERROR_MEMORY;
+      ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: compute_transfer(): memory allocation\n");
+      return;
+    }
+    clt->computed_transfer=1;
+    clt->transfer_method=method;
+  }
+
+  //The radial factors of the native non-Limber integrals are shared by all multipoles
+  TransferChiCache cache={0,NULL,NULL,NULL,NULL,NULL};
+  double *sqpk=NULL;
+  if((method==CCL_NONLIMBER_METHOD_NATIVE) && (clt->tracer_type!=CL_TRACER_CL)) {
+    int need_cache=0;
+    for(il=0;il<clt->n_ls;il++) {
+      if((w->l_arr[il]<=w->l_limber) && (clt->spl_transfer[il]==NULL) &&
+	 ((todo==NULL) || todo[il]))
+	need_cache=1;
+    }
+    if(need_cache) {
+      transfer_chi_cache_init(cosmo,w,clt,&cache,status);
+      if(*status==0) {
+	sqpk=(double *)malloc(CCL_TRANSFER_KBLOCK*CCL_MAX(cache.nchi,1)*sizeof(double));
+	if(sqpk==NULL) {
+	  *status=CCL_ERROR_MEMORY;
+	  ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: compute_transfer(): memory allocation\n");
+	}
+      }
+    }
+  }
+
+  //Loop over multipoles and compute transfer function for each
+  for(il=0;(*status==0) && (il<clt->n_ls);il++) {
     int ik,nk;
+    if((w->l_arr[il]>w->l_limber) || (clt->spl_transfer[il]!=NULL) ||
+       ((todo!=NULL) && !todo[il]))
+      continue;
     double l=(double)(w->l_arr[il]);
     double *lkarr=get_lkarr(cosmo,w,l,chimin,chimax,&nk,status);
     if(lkarr==NULL) {
@@ -991,11 +1548,18 @@ static void compute_transfer(CCL_ClTracer *clt,ccl_cosmology *cosmo,CCL_ClWorksp
     }
     clt->n_k[il]=nk;
 
-    //Loop over k and compute transfer function
-    for(ik=0;ik<nk;ik++)
-      tkarr[ik]=transfer_wrap(il,lkarr[ik],cosmo,w,clt,status);
+    if(method==CCL_NONLIMBER_METHOD_LEVIN)
+      transfer_levin(cosmo,w,clt,w->l_arr[il],nk,lkarr,tkarr,status);
+    else if(clt->tracer_type==CL_TRACER_CL) {
+      //Only the Levin integrator goes beyond Limber's approximation for CMB lensing
+      for(ik=0;ik<nk;ik++)
+	tkarr[ik]=transfer_wrap(il,lkarr[ik],cosmo,w,clt,NULL,NULL,NULL,status);
+    }
+    else if(method==CCL_NONLIMBER_METHOD_FFTLOG)
+      transfer_fftlog(cosmo,w,clt,w->l_arr[il],nk,lkarr,tkarr,status);
+    else
+      transfer_native(cosmo,w,clt,il,&cache,sqpk,nk,lkarr,tkarr,status);
     if(*status) {
-      free(clt->n_k);
       free(lkarr);
       free(tkarr);
       break;
@@ -1003,37 +1567,47 @@ static void compute_transfer(CCL_ClTracer *clt,ccl_cosmology *cosmo,CCL_ClWorksp
 
     //Initialize spline for this ell
     clt->spl_transfer[il]=ccl_spline_init(nk,lkarr,tkarr,0,0);
+    free(lkarr);
+    free(tkarr);
     if(clt->spl_transfer[il]==NULL) {
-      free(lkarr);
-      free(tkarr);
       *status=CCL_ERROR_MEMORY;
       ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: compute_transfer(): memory allocation\n");
       break;
     }
-    free(lkarr);
-    free(tkarr);
-  }
-  if(*status) {
-    free(clt->n_k);
-    int ill;
-    for(ill=0;ill<il;ill++)
-      ccl_spline_free(clt->spl_transfer[il]);
-    free(clt->spl_transfer);
   }
+  transfer_chi_cache_free(&cache);
+  free(sqpk);
+  if(*status)
+    cl_tracer_free_transfer(clt);
+}
+
+//Method used instead of Angpow for the tracers it can't handle, or for all of them
+//when CCL was built without it (see angular_cls_nonlimber_method)
+#ifdef HAVE_ANGPOW
+#define CCL_NONLIMBER_METHOD_ANGPOW_FALLBACK CCL_NONLIMBER_METHOD_LEVIN
+#else
+#define CCL_NONLIMBER_METHOD_ANGPOW_FALLBACK CCL_NONLIMBER_METHOD_NATIVE
+#endif
 
-  clt->computed_transfer=1;
+//Non-Limber method the transfer functions are computed with
+static int workspace_transfer_method(CCL_ClWorkspace *w)
+{
+  return (w->nlimb_method==CCL_NONLIMBER_METHOD_ANGPOW) ?
+    CCL_NONLIMBER_METHOD_ANGPOW_FALLBACK : w->nlimb_method;
 }
 
 static double transfer(int il,double lk,ccl_cosmology *cosmo,
 		       CCL_ClWorkspace *w,CCL_ClTracer *clt,int *status)
 {
-  if(il<w->l_limber) {
-    if(!(clt->computed_transfer))
-      compute_transfer(clt,cosmo,w,status);
+  if(w->l_arr[il]<=w->l_limber) {
+    if(!(clt->computed_transfer) || (clt->spl_transfer[il]==NULL))
+      compute_transfer(clt,cosmo,w,workspace_transfer_method(w),NULL,status);
+    if(*status)
+      return 0;
 
     return ccl_spline_eval(lk,clt->spl_transfer[il]);
   } else {
-    return transfer_wrap(il,lk,cosmo,w,clt,status);
+    return transfer_wrap(il,lk,cosmo,w,clt,NULL,NULL,NULL,status);
   }
 }
 
@@ -1150,95 +1724,864 @@ static double ccl_angular_cl_native(ccl_cosmology *cosmo,CCL_ClWorkspace *cw,int
   if(gslstatus!=GSL_SUCCESS || *ipar.status) {
     ccl_raise_gsl_warning(gslstatus, "ccl_cls.c: ccl_angular_cl_native():");
     // If an error status was already set, don't overwrite it.
-    if(*status == 0){
-        *status=CCL_ERROR_INTEG;
-        ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cl_native(): error integrating over k\n");
-    }
+    // The status message is set by the caller, outside of any parallel region.
+    if(*status == 0)
+      *status=CCL_ERROR_INTEG;
     return -1;
   }
-  ccl_check_status(cosmo,status);
 
   return result*M_LN10*2./M_PI;
 }
 
-void ccl_angular_cls(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
-		     CCL_ClTracer *clt1,CCL_ClTracer *clt2,
-		     int nl_out,int *l_out,double *cl_out,int *status)
+//Whether the Limber kernel of a tracer can be computed on a grid in chi
+//shared by all multipoles. The RSD term couples different distances at
+//fixed k, so tracers with RSD must go through the QAG integrator.
+static int limber_grid_supported(CCL_ClTracer *clt)
 {
-  int ii;
-  //First check if ell range is within workspace
-  for(ii=0;ii<nl_out;ii++) {
-    if(l_out[ii]>w->lmax) {
-      *status=CCL_ERROR_SPLINE_EV;
-      ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls(); "
-	     "requested l beyond range allowed by workspace\n");
-      return;
+  if((clt->tracer_type==CL_TRACER_NC) && (clt->has_rsd))
+    return 0;
+  return 1;
+}
+
+//Multipole-dependent prefactor of the second term of the Limber kernel
+//(see limber_grid_kernel)
+static double limber_grid_ell_prefactor(CCL_ClTracer *clt,int l)
+{
+  if(clt->tracer_type==CL_TRACER_NC)
+    return -2*clt->prefac_lensing*l*(l+1.);
+  else if(clt->tracer_type==CL_TRACER_WL)
+    return sqrt((l+2.)*(l+1.)*l*(l-1.));
+  else
+    return l*(l+1.);
+}
+
+//Radial kernels of a tracer on a grid of comoving distances.
+//In Limber's approximation the transfer function at multipole l and k=(l+1/2)/chi is
+//  j_l(k)*sqrt(P(k,a(chi)))*[f0(chi)+c_l*f2(chi)/k^2],
+//where c_l is given by limber_grid_ell_prefactor. Only f0 and f2 depend on the tracer.
+static void limber_grid_kernel(ccl_cosmology *cosmo,CCL_ClTracer *clt,int nchi,double *chi,double *a,
+			       double *f0,double *f2,int *status)
+{
+  int i;
+  for(i=0;i<nchi;i++) {
+    f0[i]=0;
+    f2[i]=0;
+    if(clt->tracer_type==CL_TRACER_NC) {
+      f0[i]=f_dens(a[i],cosmo,clt,status);
+      if(clt->has_magnification)
+	f2[i]=f_mag(a[i],chi[i],cosmo,clt,status);
+    }
+    else if(clt->tracer_type==CL_TRACER_WL) {
+      f2[i]=f_lensing(a[i],chi[i],cosmo,clt,status);
+      if(clt->has_intrinsic_alignment)
+	f2[i]+=f_IA_NLA(a[i],chi[i],cosmo,clt,status);
+    }
+    else if(clt->tracer_type==CL_TRACER_CL) {
+      if(chi[i]<clt->chi_source)
+	f2[i]=clt->prefac_lensing*(1-chi[i]/clt->chi_source)/(a[i]*chi[i]);
     }
   }
+}
 
-  //Allocate array for power spectrum at interpolation nodes
-  double *l_nodes=(double *)malloc(w->n_ls*sizeof(double));
-  if(l_nodes==NULL) {
+//Range of comoving distances covered by the Limber integral of a pair of tracers
+//at multipole l, following the k-interval used by the QAG integrator
+static void limber_grid_chi_range(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				  CCL_ClTracer *clt1,CCL_ClTracer *clt2,int l,
+				  double *chi_lo,double *chi_hi)
+{
+  double lkmin,lkmax;
+  get_k_interval(cosmo,w,clt1,clt2,l,&lkmin,&lkmax);
+  *chi_lo=(l+0.5)*pow(10.,-lkmax);
+  *chi_hi=fmin((l+0.5)*pow(10.,-lkmin),fmin(clt1->chimax,clt2->chimax));
+}
+
+//Index of the first node of a logarithmic grid with nodes at chi[i]=10^((m0+i)*dlchi)
+//that is not below chi_lo
+static int limber_grid_index(int nchi,double *chi,int m0,double dlchi,double chi_lo)
+{
+  int i=(int)ceil(log10(chi_lo)/dlchi)-m0;
+  if(i<0) i=0;
+  if(i>nchi) i=nchi;
+  while((i>0) && (chi[i-1]>=chi_lo)) i--;
+  while((i<nchi) && (chi[i]<chi_lo)) i++;
+  return i;
+}
+
+//Compute the Limber power spectra of a set of pairs of tracers at all nodes beyond
+//l_limber on a fixed grid in chi.
+//Changing variables to chi=(l+1/2)/k, the Limber integral becomes
+//  C_l = \int dln(chi) K_1(chi) K_2(chi) P((l+1/2)/chi,a(chi))/chi,
+//with K the bracket in limber_grid_kernel. The kernels and a(chi) are computed once on a
+//logarithmic grid and each C_l is a trapezoidal sum over the nodes that fall within the
+//same k-interval used by the QAG integrator. The power spectrum is evaluated once per
+//multipole and shared by all pairs. The grid nodes are the multiples of dlchi in log10(chi)
+//within the range needed by any pair, so the result for a given pair doesn't depend on
+//which other pairs are computed alongside it.
+//Pairs involving tracers not supported by the grid (see limber_grid_supported) are skipped.
+//tracers -> array of ntracers tracers
+//pair1, pair2 -> indices in tracers of the two tracers of each of the npairs pairs
+//cl_nodes -> output, with the nodes of pair ip starting at cl_nodes[ip*w->n_ls]
+static void angular_cls_limber_grid(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				    int ntracers,CCL_ClTracer **tracers,
+				    int npairs,int *pair1,int *pair2,
+				    double *cl_nodes,int *status)
+{
+  int ii,ip,it;
+  double chi_lo,chi_hi;
+
+  //Range of distances needed by any pair and multipole
+  double chimin=-1,chimax=-1;
+  for(ip=0;ip<npairs;ip++) {
+    CCL_ClTracer *clt1=tracers[pair1[ip]],*clt2=tracers[pair2[ip]];
+    if(!(limber_grid_supported(clt1) && limber_grid_supported(clt2)))
+      continue;
+    for(ii=0;ii<w->n_ls;ii++) {
+      int l=w->l_arr[ii];
+      if(l<=w->l_limber)
+	continue;
+      //Kernels that don't overlap give zero
+      cl_nodes[ip*w->n_ls+ii]=0;
+      limber_grid_chi_range(cosmo,w,clt1,clt2,l,&chi_lo,&chi_hi);
+      if((chi_lo>0) && (chi_hi>chi_lo)) {
+	if((chimin<0) || (chi_lo<chimin)) chimin=chi_lo;
+	if(chi_hi>chimax) chimax=chi_hi;
+      }
+    }
+  }
+  if((chimin<=0) || (chimax<=chimin))
+    return;
+
+  int m0=(int)floor(log10(chimin)/w->dlchi);
+  int nchi=(int)ceil(log10(chimax)/w->dlchi)-m0+1;
+  double dlnchi=w->dlchi*M_LN10;
+  double *chi=(double *)malloc((2+2*ntracers)*nchi*sizeof(double));
+  if(chi==NULL) {
     *status=CCL_ERROR_MEMORY;
-    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls(); memory allocation\n");
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: angular_cls_limber_grid(); memory allocation\n");
     return;
   }
-  double *cl_nodes=(double *)malloc(w->n_ls*sizeof(double));
-  if(cl_nodes==NULL) {
-    free(l_nodes);
-    *status=CCL_ERROR_MEMORY;
-    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_angular_cls(); memory allocation\n");
+  double *a=&(chi[nchi]);
+  for(ii=0;ii<nchi;ii++)
+    chi[ii]=pow(10.,(m0+ii)*w->dlchi);
+
+  //Scale factor and kernels of each tracer on the grid
+  ccl_scale_factor_of_chis(cosmo,nchi,chi,a,status);
+  for(it=0;it<ntracers;it++) {
+    if(limber_grid_supported(tracers[it]))
+      limber_grid_kernel(cosmo,tracers[it],nchi,chi,a,
+			 &(chi[(2+2*it)*nchi]),&(chi[(3+2*it)*nchi]),status);
+  }
+  if(*status) {
+    free(chi);
     return;
   }
-  for(ii=0;ii<w->n_ls;ii++)
-    l_nodes[ii]=(double)(w->l_arr[ii]);
 
-  //Now check if angpow is needed at all
-  int method_use=w->nlimb_method;
+  int status_grid=0;
+#pragma omp parallel num_threads(ccl_cosmology_num_threads(cosmo)) private(ip,chi_lo,chi_hi)
+  {
+    int status_this=0;
+    double *k=(double *)malloc(2*nchi*sizeof(double));
+    int *i_lo=(int *)malloc(2*npairs*sizeof(int));
+    double *pk=&(k[nchi]);
+    int *i_hi=&(i_lo[npairs]);
+    if((k==NULL) || (i_lo==NULL))
+      status_this=CCL_ERROR_MEMORY;
+
+#pragma omp for schedule(dynamic)
+    for(ii=0;ii<w->n_ls;ii++) {
+      int i,i0=nchi,i1=-1,l=w->l_arr[ii];
+      if((l<=w->l_limber) || status_this)
+	continue;
+
+      //Grid nodes within the range of each pair
+      for(ip=0;ip<npairs;ip++) {
+	CCL_ClTracer *clt1=tracers[pair1[ip]],*clt2=tracers[pair2[ip]];
+	i_lo[ip]=0;
+	i_hi[ip]=-1;
+	if(!(limber_grid_supported(clt1) && limber_grid_supported(clt2)))
+	  continue;
+	limber_grid_chi_range(cosmo,w,clt1,clt2,l,&chi_lo,&chi_hi);
+	if((chi_lo<=0) || (chi_hi<=chi_lo))
+	  continue;
+	i_lo[ip]=limber_grid_index(nchi,chi,m0,w->dlchi,chi_lo);
+	i_hi[ip]=limber_grid_index(nchi,chi,m0,w->dlchi,chi_hi)-1;
+	if((i_hi[ip]<nchi-1) && (chi[i_hi[ip]+1]<=chi_hi))
+	  i_hi[ip]++;
+	if(i_hi[ip]>i_lo[ip]) {
+	  if(i_lo[ip]<i0) i0=i_lo[ip];
+	  if(i_hi[ip]>i1) i1=i_hi[ip];
+	}
+      }
+      if(i1<=i0)
+	continue;
+
+      //Power spectrum, shared by all pairs
+      int n=i1-i0+1;
+      for(i=0;i<n;i++)
+	k[i]=(l+0.5)/chi[i0+i];
+      ccl_nonlin_matter_powers(cosmo,n,k,&(a[i0]),pk,&status_this);
+      for(i=0;i<n;i++)
+	pk[i]*=dlnchi/chi[i0+i];
+
+      for(ip=0;ip<npairs;ip++) {
+	if(i_hi[ip]<=i_lo[ip])
+	  continue;
+	CCL_ClTracer *clt1=tracers[pair1[ip]],*clt2=tracers[pair2[ip]];
+	double *f0_1=&(chi[(2+2*pair1[ip])*nchi]),*f2_1=&(chi[(3+2*pair1[ip])*nchi]);
+	double *f0_2=&(chi[(2+2*pair2[ip])*nchi]),*f2_2=&(chi[(3+2*pair2[ip])*nchi]);
+	double c1=limber_grid_ell_prefactor(clt1,l);
+	double c2=limber_grid_ell_prefactor(clt2,l);
+	double sum=0;
+	for(i=i_lo[ip]-i0;i<=i_hi[ip]-i0;i++) {
+	  int j=i0+i;
+	  double ik2=1./(k[i]*k[i]);
+	  double kern1=f0_1[j]+c1*ik2*f2_1[j];
+	  double kern2=f0_2[j]+c2*ik2*f2_2[j];
+	  double wt=((j==i_lo[ip]) || (j==i_hi[ip])) ? 0.5 : 1.;
+	  sum+=wt*kern1*kern2*pk[i];
+	}
+	cl_nodes[ip*w->n_ls+ii]=sum;
+      }
+    }
+
+    free(k);
+    free(i_lo);
+#pragma omp critical(ccl_cls_limber_grid)
+    {
+      if(status_grid==0)
+	status_grid=status_this;
+    }
+  }
+
+  if(status_grid) {
+    *status=status_grid;
+    if(status_grid==CCL_ERROR_MEMORY)
+      ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: angular_cls_limber_grid(); memory allocation\n");
+  }
+
+  free(chi);
+}
+
+//Whether a tracer is one of the bias templates of a number counts tracer
+static int cl_tracer_is_template(CCL_ClTracer *clt)
+{
+  return (clt->tracer_type==CL_TRACER_NC) && ((!clt->has_density) || (clt->spl_bz==NULL));
+}
+
+//Warns that Angpow was requested but another non-Limber method is used. The fallback
+//only depends on the tracer types and on how CCL was built, so the warning is only
+//raised once per process rather than for every pair and every call.
+static void warn_angpow_fallback(void)
+{
+  static int warned=0;
+  int warn;
+#pragma omp critical(ccl_angpow_warning)
+  {
+    warn=!warned;
+    warned=1;
+  }
+  if(!warn)
+    return;
+#ifdef HAVE_ANGPOW
+  ccl_raise_warning(CCL_ERROR_NOT_IMPLEMENTED,
+		    "ccl_cls.c: Angpow can't compute shear, magnification, CMB lensing "
+		    "or bias templates; using the Levin integrator for them instead");
+#else
+  ccl_raise_warning(CCL_ERROR_NOT_IMPLEMENTED,
+		    "ccl_cls.c: CCL was built without Angpow; "
+		    "using the native non-Limber method instead");
+#endif
+}
+
+//Non-Limber method actually used for a pair of tracers.
+//Angpow only integrates the density and RSD kernels of number counts tracers. Pairs
+//involving shear, magnification or CMB lensing, as well as bias templates (which Angpow
+//knows nothing about), use the adaptive Levin integrator instead of the native chi sums.
+//Without Angpow support, all pairs use the native method. Both fallbacks are reported
+//by warn_angpow_fallback().
+static int angular_cls_nonlimber_method(CCL_ClWorkspace *w,CCL_ClTracer *clt1,CCL_ClTracer *clt2)
+{
+  if(w->nlimb_method==CCL_NONLIMBER_METHOD_ANGPOW) {
+    int method=CCL_NONLIMBER_METHOD_ANGPOW;
+    if((clt1->tracer_type!=CL_TRACER_NC) || (clt2->tracer_type!=CL_TRACER_NC) ||
+       clt1->has_magnification || clt2->has_magnification)
+      method=CCL_NONLIMBER_METHOD_ANGPOW_FALLBACK;
+    if(cl_tracer_is_template(clt1) || cl_tracer_is_template(clt2))
+      method=CCL_NONLIMBER_METHOD_ANGPOW_FALLBACK;
+#ifndef HAVE_ANGPOW
+    method=CCL_NONLIMBER_METHOD_ANGPOW_FALLBACK;
+#endif
+    if((method!=CCL_NONLIMBER_METHOD_ANGPOW) && (w->l_limber>=0))
+      warn_angpow_fallback();
+    return method;
+  }
+  return w->nlimb_method;
+}
+
+//Compute the power spectrum of a pair of tracers at the nodes of the workspace flagged
+//in todo (all of them if todo is NULL).
+//The Limber nodes are skipped if limber_done is set (i.e. if they were computed on the
+//Limber grid). The remaining nodes are computed in parallel, each with its own status.
+//Anything that would otherwise be computed lazily, other than the transfer functions
+//of the tracers, must have been computed beforehand.
+static void angular_cls_pair_nodes(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				   CCL_ClTracer *clt1,CCL_ClTracer *clt2,int limber_done,
+				   const int *todo,double *cl_nodes,int *status)
+{
+  int ii;
+  int method_use=angular_cls_nonlimber_method(w,clt1,clt2);
+
+#ifdef HAVE_ANGPOW
+  //Use angpow if non-limber is needed
   if(method_use==CCL_NONLIMBER_METHOD_ANGPOW) {
     int do_angpow=0;
     for(ii=0;ii<w->n_ls;ii++) {
-      if(w->l_arr[ii]<=w->l_limber)
+      if((w->l_arr[ii]<=w->l_limber) && ((todo==NULL) || todo[ii]))
 	do_angpow=1;
     }
-    //Resort to native method if we have lensing (this will hopefully only be temporary)
-    if(clt1->tracer_type==CL_TRACER_WL || clt2->tracer_type==CL_TRACER_WL ||
-       clt1->has_magnification || clt2->has_magnification) {
-      do_angpow=0;
-      method_use=CCL_NONLIMBER_METHOD_NATIVE;
-    }
-    //Use angpow if non-limber is needed
-#ifdef HAVE_ANGPOW
     if(do_angpow)
       ccl_angular_cls_angpow(cosmo,w,clt1,clt2,cl_nodes,status);
-    ccl_check_status(cosmo,status);
-#else
-    do_angpow=0;
-    method_use=CCL_NONLIMBER_METHOD_NATIVE;
+    if(*status)
+      return;
+  }
 #endif
+
+  if((method_use!=CCL_NONLIMBER_METHOD_ANGPOW) && (w->l_limber>=0)) {
+    //Transfer functions computed with a different method can't be reused
+    if(clt1->computed_transfer && (clt1->transfer_method!=method_use))
+      cl_tracer_free_transfer(clt1);
+    if(clt2->computed_transfer && (clt2->transfer_method!=method_use))
+      cl_tracer_free_transfer(clt2);
+    compute_transfer(clt1,cosmo,w,method_use,todo,status);
+    if(*status==0)
+      compute_transfer(clt2,cosmo,w,method_use,todo,status);
+    if(*status)
+      return;
+  }
+
+  int *status_nodes=(int *)calloc(w->n_ls,sizeof(int));
+  if(status_nodes==NULL) {
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls(); memory allocation\n");
+    return;
   }
 
-  //Compute limber nodes
+#pragma omp parallel for num_threads(ccl_cosmology_num_threads(cosmo)) schedule(dynamic)
   for(ii=0;ii<w->n_ls;ii++) {
-    if((method_use==CCL_NONLIMBER_METHOD_NATIVE) || (w->l_arr[ii]>w->l_limber))
-      cl_nodes[ii]=ccl_angular_cl_native(cosmo,w,ii,clt1,clt2,status);
+    if((todo!=NULL) && !todo[ii])
+      continue;
+    if(w->l_arr[ii]>w->l_limber) {
+      if(!limber_done)
+	cl_nodes[ii]=ccl_angular_cl_native(cosmo,w,ii,clt1,clt2,&(status_nodes[ii]));
+    }
+    else if(method_use!=CCL_NONLIMBER_METHOD_ANGPOW)
+      cl_nodes[ii]=ccl_angular_cl_native(cosmo,w,ii,clt1,clt2,&(status_nodes[ii]));
   }
 
-  //Interpolate into ells requested by user
-  SplPar *spcl_nodes=ccl_spline_init(w->n_ls,l_nodes,cl_nodes,0,0);
+  //Report the error from the first failed node, as the serial loop would
+  for(ii=0;ii<w->n_ls;ii++) {
+    if(status_nodes[ii]) {
+      *status=status_nodes[ii];
+      if(*status==CCL_ERROR_INTEG)
+	ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cl_native(): error integrating over k\n");
+      break;
+    }
+  }
+  free(status_nodes);
+}
+
+//Spline of the power spectrum through the workspace nodes flagged in is_node.
+//Returns NULL if it couldn't be allocated.
+static SplPar *angular_cls_nodes_spline(CCL_ClWorkspace *w,const int *is_node,const double *cl_nodes)
+{
+  int ii,n=0;
+  double *l_nodes=(double *)malloc(2*w->n_ls*sizeof(double));
+  if(l_nodes==NULL)
+    return NULL;
+  double *cl_use=&(l_nodes[w->n_ls]);
+
+  for(ii=0;ii<w->n_ls;ii++) {
+    if(is_node[ii]) {
+      l_nodes[n]=(double)(w->l_arr[ii]);
+      cl_use[n]=cl_nodes[ii];
+      n++;
+    }
+  }
+  SplPar *spl=ccl_spline_init(n,l_nodes,cl_use,0,0);
+  free(l_nodes);
+  return spl;
+}
+
+//Interpolate the power spectrum at the workspace nodes flagged in is_node and bin it.
+//The binning is a sparse matrix in CSR format: output ib is the sum of band_w[j]*C(band_l[j])
+//for j in [band_ptr[ib],band_ptr[ib+1]). If band_ptr is NULL, output ib is C(band_l[ib])
+//(i.e. the power spectrum is just interpolated into the multipoles in band_l).
+static void angular_cls_bin(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+			    const int *is_node,const double *cl_nodes,
+			    int nb,const int *band_ptr,const int *band_l,const double *band_w,
+			    double *cl_out,int *status)
+{
+  int ib,j;
+  SplPar *spcl_nodes=angular_cls_nodes_spline(w,is_node,cl_nodes);
   if(spcl_nodes==NULL) {
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_angular_cls(); memory allocation\n");
+    return;
+  }
+
+  if(band_ptr==NULL) {
+    for(ib=0;ib<nb;ib++)
+      cl_out[ib]=ccl_spline_eval((double)(band_l[ib]),spcl_nodes);
+    ccl_spline_free(spcl_nodes);
+    return;
+  }
+
+  //Interpolate once into all the multipoles spanned by the windows,
+  //which usually overlap, and multiply by the window matrix
+  int nnz=band_ptr[nb];
+  int lmin=w->lmax,lmax=0;
+  for(j=0;j<nnz;j++) {
+    lmin=CCL_MIN(lmin,band_l[j]);
+    lmax=CCL_MAX(lmax,band_l[j]);
+  }
+  double *cl_l=(double *)malloc(CCL_MAX(lmax-lmin+1,1)*sizeof(double));
+  if(cl_l==NULL) {
+    ccl_spline_free(spcl_nodes);
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls_bandpowers(); memory allocation\n");
+    return;
+  }
+  for(j=lmin;j<=lmax;j++)
+    cl_l[j-lmin]=ccl_spline_eval((double)j,spcl_nodes);
+  ccl_spline_free(spcl_nodes);
+
+  for(ib=0;ib<nb;ib++) {
+    double sum=0;
+    for(j=band_ptr[ib];j<band_ptr[ib+1];j++)
+      sum+=band_w[j]*cl_l[band_l[j]-lmin];
+    cl_out[ib]=sum;
+  }
+  free(cl_l);
+}
+
+//Ratio between consecutive multipoles of the initial nodes of the adaptive sampling
+#define CCL_CL_ADAPTIVE_LFAC 2.
+//Workspaces with fewer nodes than this are always computed at all of them
+#define CCL_CL_ADAPTIVE_NMIN 8
+//Number of successive bisections an interval must pass before it is considered converged.
+//Requiring more than one makes it harder for oscillations to fool the test.
+#define CCL_CL_ADAPTIVE_NPASS 2
+
+//Compute the power spectrum of a pair of tracers at the nodes of the workspace needed
+//to interpolate it, flagging them in is_node.
+//If w->l_epsrel is positive, the nodes are chosen adaptively: starting from nodes spaced
+//by a factor CCL_CL_ADAPTIVE_LFAC in ell, each interval between nodes is bisected in log(ell)
+//and the power spectrum computed at the workspace node closest to the midpoint. Intervals are
+//no longer bisected once the spline through the previous nodes predicts the power spectrum
+//at their midpoint to a relative accuracy w->l_epsrel, or when no workspace node is left
+//in them. Otherwise (and for small workspaces) all the nodes are computed.
+//Nodes computed beforehand (Limber nodes if limber_done is set) are always used.
+static void angular_cls_pair_adaptive(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				      CCL_ClTracer *clt1,CCL_ClTracer *clt2,int limber_done,
+				      double *cl_nodes,int *is_node,int *status)
+{
+  int ii,n=w->n_ls;
+
+  for(ii=0;ii<n;ii++)
+    is_node[ii]=1;
+  if((w->l_epsrel<=0) || (n<CCL_CL_ADAPTIVE_NMIN)) {
+    angular_cls_pair_nodes(cosmo,w,clt1,clt2,limber_done,NULL,cl_nodes,status);
+    return;
+  }
+
+  //todo -> nodes to compute in this pass
+  //gap -> for each midpoint, the node starting the interval it bisects
+  //conv -> for each node, whether the interval starting at it has converged
+  //pred -> prediction of the power spectrum at each midpoint
+  int *todo=(int *)calloc(3*n,sizeof(int));
+  double *pred=(double *)malloc(n*sizeof(double));
+  if((todo==NULL) || (pred==NULL)) {
+    free(todo);
+    free(pred);
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls(); memory allocation\n");
+    return;
+  }
+  int *gap=&(todo[n]),*conv=&(todo[2*n]);
+
+  //Initial nodes: both ends, both sides of l_limber and a sparse logarithmic sampling.
+  //Nodes that are computed all at once anyway (Angpow, Limber grid) are all used.
+  int angpow=(angular_cls_nonlimber_method(w,clt1,clt2)==CCL_NONLIMBER_METHOD_ANGPOW);
+  int il_prev=0;
+  for(ii=0;ii<n;ii++) {
+    int is_limber=(w->l_arr[ii]>w->l_limber);
+    if(is_limber && limber_done)
+      is_node[ii]=1;
+    else {
+      is_node[ii]=0;
+      gap[ii]=-1;
+      todo[ii]=((ii==0) || (ii==n-1) || (!is_limber && angpow) ||
+		(w->l_arr[ii]>=CCL_CL_ADAPTIVE_LFAC*w->l_arr[il_prev]) ||
+		((ii<n-1) && (w->l_arr[ii]<=w->l_limber) && (w->l_arr[ii+1]>w->l_limber)) ||
+		((ii>0) && (w->l_arr[ii-1]<=w->l_limber) && is_limber));
+      if(todo[ii])
+	il_prev=ii;
+    }
+  }
+
+  while(*status==0) {
+    angular_cls_pair_nodes(cosmo,w,clt1,clt2,limber_done,todo,cl_nodes,status);
+    if(*status)
+      break;
+
+    //Check the predictions at the new midpoints and add them to the nodes
+    for(ii=0;ii<n;ii++) {
+      if(todo[ii] && !is_node[ii]) {
+	if(gap[ii]>=0) {
+	  int ok=(fabs(cl_nodes[ii]-pred[ii])<=w->l_epsrel*fabs(cl_nodes[ii]));
+	  conv[ii]=ok ? conv[gap[ii]]+1 : 0;
+	  conv[gap[ii]]=conv[ii];
+	}
+	is_node[ii]=1;
+      }
+      todo[ii]=0;
+      gap[ii]=-1;
+    }
+
+    //Bisect the intervals that haven't converged
+    SplPar *spl=angular_cls_nodes_spline(w,is_node,cl_nodes);
+    if(spl==NULL) {
+      *status=CCL_ERROR_MEMORY;
+      ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls(); memory allocation\n");
+      break;
+    }
+    int n_new=0,ia=0;
+    while(ia<n-1) {
+      int ib=ia+1;
+      while(!is_node[ib])
+	ib++;
+      if((conv[ia]<CCL_CL_ADAPTIVE_NPASS) && (ib-ia>=2)) {
+	//Workspace node closest to the midpoint in log(ell)
+	int la=w->l_arr[ia],lb=w->l_arr[ib];
+	double l_mid=(la>0) ? sqrt((double)la*lb) : 0.5*lb;
+	int im=ia+1;
+	for(ii=ia+2;ii<ib;ii++) {
+	  if(fabs(w->l_arr[ii]-l_mid)<fabs(w->l_arr[im]-l_mid))
+	    im=ii;
+	}
+	todo[im]=1;
+	gap[im]=ia;
+	pred[im]=ccl_spline_eval((double)(w->l_arr[im]),spl);
+	n_new++;
+      }
+      else
+	conv[ia]=CCL_CL_ADAPTIVE_NPASS;
+      ia=ib;
+    }
+    ccl_spline_free(spl);
+    if(n_new==0)
+      break;
+  }
+
+  free(todo);
+  free(pred);
+}
+
+//Check that the multipoles requested are within the workspace and compute everything
+//that would otherwise be computed lazily while evaluating the nodes in parallel
+static void angular_cls_prepare(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				int nl_out,int *l_out,int *status)
+{
+  int ii;
+  for(ii=0;ii<nl_out;ii++) {
+    if(l_out[ii]>w->lmax) {
+      *status=CCL_ERROR_SPLINE_EV;
+      ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls(); "
+	     "requested l beyond range allowed by workspace\n");
+      return;
+    }
+  }
+
+  ccl_cosmology_compute_distances(cosmo,status);
+  ccl_cosmology_compute_growth(cosmo,status);
+  ccl_cosmology_compute_power(cosmo,status);
+}
+
+void ccl_angular_cls(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+		     CCL_ClTracer *clt1,CCL_ClTracer *clt2,
+		     int nl_out,int *l_out,double *cl_out,int *status)
+{
+  angular_cls_prepare(cosmo,w,nl_out,l_out,status);
+  if(*status)
+    return;
+
+  //Allocate array for power spectrum at interpolation nodes
+  double *cl_nodes=(double *)malloc(w->n_ls*sizeof(double));
+  if(cl_nodes==NULL) {
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_angular_cls(); memory allocation\n");
+    return;
+  }
+  int *is_node=(int *)malloc(w->n_ls*sizeof(int));
+  if(is_node==NULL) {
     free(cl_nodes);
     *status=CCL_ERROR_MEMORY;
     ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_cl_angular_cls(); memory allocation\n");
     return;
   }
-  for(ii=0;ii<nl_out;ii++)
-    cl_out[ii]=ccl_spline_eval((double)(l_out[ii]),spcl_nodes);
+
+  //With CCL_LIMBER_METHOD_GRID, all Limber nodes are computed at once beforehand
+  int use_grid=((w->limber_method==CCL_LIMBER_METHOD_GRID) &&
+		limber_grid_supported(clt1) && limber_grid_supported(clt2));
+  if(use_grid) {
+    CCL_ClTracer *tracers[2]={clt1,clt2};
+    int ntracers=(clt1==clt2) ? 1 : 2;
+    int pair1=0,pair2=ntracers-1;
+    angular_cls_limber_grid(cosmo,w,ntracers,tracers,1,&pair1,&pair2,cl_nodes,status);
+  }
+
+  //Compute the remaining nodes
+  if(*status==0)
+    angular_cls_pair_adaptive(cosmo,w,clt1,clt2,use_grid,cl_nodes,is_node,status);
+  ccl_check_status(cosmo,status);
+
+  //Interpolate into ells requested by user
+  if(*status==0)
+    angular_cls_bin(cosmo,w,is_node,cl_nodes,nl_out,NULL,l_out,NULL,cl_out,status);
 
   //Cleanup
-  ccl_spline_free(spcl_nodes);
   free(cl_nodes);
-  free(l_nodes);
+  free(is_node);
+}
+
+//Computes the power spectra of a set of pairs of tracers and bins them (see angular_cls_bin).
+//The output for pair ip and bin ib is stored in cl_out[ip*nb+ib].
+static void angular_cls_pairs_binned(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				     int ntracers,CCL_ClTracer **tracers,
+				     int npairs,int *pair1,int *pair2,
+				     int nb,int *band_ptr,int *band_l,double *band_w,
+				     double *cl_out,int *status)
+{
+  int ip;
+  for(ip=0;ip<npairs;ip++) {
+    if((pair1[ip]<0) || (pair1[ip]>=ntracers) || (pair2[ip]<0) || (pair2[ip]>=ntracers)) {
+      *status=CCL_ERROR_INCONSISTENT;
+      ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls_matrix(); "
+	     "tracer index out of range\n");
+      return;
+    }
+  }
+  angular_cls_prepare(cosmo,w,(band_ptr==NULL) ? nb : band_ptr[nb],band_l,status);
+  if(*status)
+    return;
+
+  //Allocate arrays for the power spectra at interpolation nodes
+  double *cl_nodes=(double *)malloc(npairs*w->n_ls*sizeof(double));
+  if(cl_nodes==NULL) {
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls_matrix(); memory allocation\n");
+    return;
+  }
+  int *is_node=(int *)malloc(w->n_ls*sizeof(int));
+  if(is_node==NULL) {
+    free(cl_nodes);
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls_matrix(); memory allocation\n");
+    return;
+  }
+
+  //With CCL_LIMBER_METHOD_GRID, the Limber nodes of all supported pairs are computed
+  //together, evaluating the power spectrum only once
+  int use_grid=(w->limber_method==CCL_LIMBER_METHOD_GRID);
+  if(use_grid)
+    angular_cls_limber_grid(cosmo,w,ntracers,tracers,npairs,pair1,pair2,cl_nodes,status);
+
+  //Compute the remaining nodes and interpolate
+  for(ip=0;ip<npairs;ip++) {
+    CCL_ClTracer *clt1=tracers[pair1[ip]],*clt2=tracers[pair2[ip]];
+    int limber_done=(use_grid && limber_grid_supported(clt1) && limber_grid_supported(clt2));
+    if(*status==0)
+      angular_cls_pair_adaptive(cosmo,w,clt1,clt2,limber_done,&(cl_nodes[ip*w->n_ls]),
+				is_node,status);
+    if(*status==0)
+      angular_cls_bin(cosmo,w,is_node,&(cl_nodes[ip*w->n_ls]),
+		      nb,band_ptr,band_l,band_w,&(cl_out[ip*nb]),status);
+  }
+  ccl_check_status(cosmo,status);
+
+  //Cleanup
+  free(cl_nodes);
+  free(is_node);
+}
+
+void ccl_angular_cls_matrix(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+			    int ntracers,CCL_ClTracer **tracers,
+			    int npairs,int *pair1,int *pair2,
+			    int nl_out,int *l_out,double *cl_out,int *status)
+{
+  angular_cls_pairs_binned(cosmo,w,ntracers,tracers,npairs,pair1,pair2,
+			   nl_out,NULL,l_out,NULL,cl_out,status);
+}
+
+void ccl_angular_cls_bandpowers(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				int ntracers,CCL_ClTracer **tracers,
+				int npairs,int *pair1,int *pair2,
+				int nb,int *band_ptr,int *band_l,double *band_w,
+				double *cl_out,int *status)
+{
+  int ib,j;
+  int windows_ok=(nb>0) && (band_ptr[0]==0);
+  for(ib=0;windows_ok && (ib<nb);ib++) {
+    if(band_ptr[ib+1]<band_ptr[ib])
+      windows_ok=0;
+  }
+  for(j=0;windows_ok && (j<band_ptr[nb]);j++) {
+    if(band_l[j]<0)
+      windows_ok=0;
+  }
+  if(!windows_ok) {
+    *status=CCL_ERROR_INCONSISTENT;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls_bandpowers(); "
+	   "bandpower windows must be in CSR format, with non-negative multipoles\n");
+    return;
+  }
+
+  angular_cls_pairs_binned(cosmo,w,ntracers,tracers,npairs,pair1,pair2,
+			   nb,band_ptr,band_l,band_w,cl_out,status);
+}
+
+//Number of bias templates of a tracer (see ccl_angular_cls_bias_templates)
+int ccl_cl_tracer_n_bias_templates(CCL_ClTracer *clt,int nzb)
+{
+  if(clt->tracer_type!=CL_TRACER_NC)
+    return 1;
+  return nzb+clt->has_rsd+clt->has_magnification;
+}
+
+//Splits a tracer into its bias templates. These are shallow copies of the tracer that
+//share all its splines, and only differ in the terms they include:
+// - One density term with unit bias for each of the nzb redshift bins
+// - The RSD term
+// - The magnification term
+//Tracers other than number counts have a single template (the tracer itself).
+static void cl_tracer_bias_templates(CCL_ClTracer *clt,int nzb,double *z_edges,
+				     CCL_ClTracer *templates)
+{
+  int ib,it=0;
+  if(clt->tracer_type!=CL_TRACER_NC) {
+    templates[0]=*clt;
+    templates[0].computed_transfer=0;
+    return;
+  }
+
+  for(ib=0;ib<nzb;ib++) {
+    CCL_ClTracer *t=&(templates[it++]);
+    *t=*clt;
+    t->computed_transfer=0;
+    t->has_rsd=0;
+    t->has_magnification=0;
+    t->spl_bz=NULL;
+    t->bz_zmin=(z_edges==NULL) ? 0 : z_edges[ib];
+    t->bz_zmax=(z_edges==NULL) ? HUGE_VAL : z_edges[ib+1];
+  }
+  if(clt->has_rsd) {
+    CCL_ClTracer *t=&(templates[it++]);
+    *t=*clt;
+    t->computed_transfer=0;
+    t->has_density=0;
+    t->has_magnification=0;
+  }
+  if(clt->has_magnification) {
+    CCL_ClTracer *t=&(templates[it++]);
+    *t=*clt;
+    t->computed_transfer=0;
+    t->has_density=0;
+    t->has_rsd=0;
+  }
+}
+
+void ccl_angular_cls_bias_templates(ccl_cosmology *cosmo,CCL_ClWorkspace *w,
+				    CCL_ClTracer *clt1,CCL_ClTracer *clt2,
+				    int nzb,double *z_edges,
+				    int nl_out,int *l_out,double *cl_out,int *status)
+{
+  int ib,i1,i2,ii;
+  int bins_ok=(nzb>=1) && ((z_edges!=NULL) || (nzb==1));
+  for(ib=0;bins_ok && (z_edges!=NULL) && (ib<nzb);ib++) {
+    if(z_edges[ib+1]<=z_edges[ib])
+      bins_ok=0;
+  }
+  if(!bins_ok) {
+    *status=CCL_ERROR_INCONSISTENT;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls_bias_templates(); "
+	   "redshift bins must be non-empty and sorted\n");
+    ccl_check_status(cosmo,status);
+    return;
+  }
+
+  //Templates of both tracers. If the two tracers are the same, the templates are only
+  //created once and only half of the pairs are computed
+  int same=(clt1==clt2);
+  int n1=ccl_cl_tracer_n_bias_templates(clt1,nzb);
+  int n2=ccl_cl_tracer_n_bias_templates(clt2,nzb);
+  int ntracers=same ? n1 : n1+n2;
+  int i2_0=same ? 0 : n1;
+  int npairs=same ? n1*(n1+1)/2 : n1*n2;
+  CCL_ClTracer *templates=(CCL_ClTracer *)malloc(ntracers*sizeof(CCL_ClTracer));
+  CCL_ClTracer **tracers=(CCL_ClTracer **)malloc(ntracers*sizeof(CCL_ClTracer *));
+  int *pair1=(int *)malloc(2*npairs*sizeof(int));
+  double *cl_pairs=(double *)malloc(npairs*nl_out*sizeof(double));
+  if((templates==NULL) || (tracers==NULL) || (pair1==NULL) || (cl_pairs==NULL)) {
+    free(templates);
+    free(tracers);
+    free(pair1);
+    free(cl_pairs);
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_cls.c: ccl_angular_cls_bias_templates(); memory allocation\n");
+    ccl_check_status(cosmo,status);
+    return;
+  }
+  int *pair2=&(pair1[npairs]);
+
+  cl_tracer_bias_templates(clt1,nzb,z_edges,templates);
+  if(!same)
+    cl_tracer_bias_templates(clt2,nzb,z_edges,&(templates[n1]));
+  for(ii=0;ii<ntracers;ii++)
+    tracers[ii]=&(templates[ii]);
+
+  int ip=0;
+  for(i1=0;i1<n1;i1++) {
+    for(i2=same ? i1 : 0;i2<n2;i2++) {
+      pair1[ip]=i1;
+      pair2[ip]=i2_0+i2;
+      ip++;
+    }
+  }
+
+  ccl_angular_cls_matrix(cosmo,w,ntracers,tracers,npairs,pair1,pair2,nl_out,l_out,cl_pairs,status);
+
+  //Unpack the pairs into the n1 x n2 array of templates
+  if(*status==0) {
+    ip=0;
+    for(i1=0;i1<n1;i1++) {
+      for(i2=same ? i1 : 0;i2<n2;i2++) {
+	for(ii=0;ii<nl_out;ii++) {
+	  cl_out[(i1*n2+i2)*nl_out+ii]=cl_pairs[ip*nl_out+ii];
+	  if(same)
+	    cl_out[(i2*n2+i1)*nl_out+ii]=cl_pairs[ip*nl_out+ii];
+	}
+	ip++;
+      }
+    }
+  }
+
+  //The templates own nothing but the transfer functions they may have computed
+  for(ii=0;ii<ntracers;ii++)
+    cl_tracer_free_transfer(&(templates[ii]));
+  free(templates);
+  free(tracers);
+  free(pair1);
+  free(cl_pairs);
 }
 
 static int check_clt_fa_inconsistency(CCL_ClTracer *clt,int func_code)
@@ -1278,6 +2621,8 @@ double ccl_get_tracer_fa(ccl_cosmology *cosmo,CCL_ClTracer *clt,double a,int fun
     spl=clt->spl_rf;
   if(func_code==CCL_CLT_BA)
     spl=clt->spl_ba;
+  if(func_code==CCL_CLT_NZ)
+    return cl_tracer_nz(clt,x);
   if((func_code==CCL_CLT_WL) || (func_code==CCL_CLT_WM)) {
     x=ccl_comoving_radial_distance(cosmo,a,status);
     if(func_code==CCL_CLT_WL)
@@ -1326,7 +2671,10 @@ int ccl_get_tracer_fas(ccl_cosmology *cosmo,CCL_ClTracer *clt,int na,double *a,d
       x=ccl_comoving_radial_distance(cosmo,a[ia],status);
     else
       x=1./a[ia]-1;
-    fa[ia]=ccl_spline_eval(x,spl);
+    if(func_code==CCL_CLT_NZ)
+      fa[ia]=cl_tracer_nz(clt,x);
+    else
+      fa[ia]=ccl_spline_eval(x,spl);
   }
 
   return 0;
@@ -9,6 +9,10 @@
 #include <gsl/gsl_spline.h>
 #include <gsl/gsl_integration.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "ccl.h"
 #include "ccl_params.h"
 
@@ -18,7 +22,7 @@
 #define STRING(s) #s
 
 
-const ccl_configuration default_config = {ccl_boltzmann_class, ccl_halofit, ccl_nobaryons, ccl_tinker10, ccl_duffy2008, ccl_emu_strict};
+const ccl_configuration default_config = {ccl_boltzmann_class, ccl_halofit, ccl_nobaryons, ccl_tinker10, ccl_duffy2008, ccl_emu_strict, 0};
 
 const ccl_gsl_params default_gsl_params = {GSL_EPSREL,                          // EPSREL
                                            GSL_N_ITERATION,                     // N_ITERATION
@@ -87,6 +91,9 @@ void ccl_cosmology_read_config(void)
     return;
   }
 
+  //CHI_SPLINE_DELTA is not in older parameter files, so it gets a default
+  ccl_splines->CHI_SPLINE_DELTA=CHI_SPLINE_DELTA_DEFAULT;
+
 #define MATCH(s, action) if (0 == strcmp(var_name, s)) { action ; continue;} do{} while(0)
 
   int lineno = 0;
@@ -108,6 +115,7 @@ void ccl_cosmology_read_config(void)
       MATCH("A_SPLINE_MINLOG_PK", ccl_splines->A_SPLINE_MINLOG_PK=var_dbl);
       MATCH("A_SPLINE_MIN_PK", ccl_splines->A_SPLINE_MIN_PK=var_dbl);
       MATCH("A_SPLINE_MAX", ccl_splines->A_SPLINE_MAX=var_dbl);
+      MATCH("CHI_SPLINE_DELTA", ccl_splines->CHI_SPLINE_DELTA=var_dbl);
       MATCH("LOGM_SPLINE_DELTA", ccl_splines->LOGM_SPLINE_DELTA=var_dbl);
       MATCH("LOGM_SPLINE_NM", ccl_splines->LOGM_SPLINE_NM=(int) var_dbl);
       MATCH("LOGM_SPLINE_MIN", ccl_splines->LOGM_SPLINE_MIN=var_dbl);
@@ -156,8 +164,6 @@ chi: comoving distance [Mpc]
 growth: growth function (density)
 fgrowth: logarithmic derivative of the growth (density) (dlnD/da?)
 E: E(a)=H(a)/H0
-accelerator: interpolation accelerator for functions of a
-accelerator_achi: interpolation accelerator for functions of chi
 growth0: growth at z=0, defined to be 1
 sigma: ?
 p_lin: linear matter power spectrum at z=0?
@@ -175,16 +181,18 @@ ccl_cosmology * ccl_cosmology_create(ccl_parameters params, ccl_configuration co
   cosmo->data.growth = NULL;
   cosmo->data.fgrowth = NULL;
   cosmo->data.E = NULL;
-  cosmo->data.accelerator=NULL;
-  cosmo->data.accelerator_achi=NULL;
-  cosmo->data.accelerator_m=NULL;
-  cosmo->data.accelerator_d=NULL;
-  cosmo->data.accelerator_k=NULL;
   cosmo->data.growth0 = 1.;
   cosmo->data.achi=NULL;
+  cosmo->data.tab_chi = NULL;
+  cosmo->data.tab_growth = NULL;
+  cosmo->data.tab_fgrowth = NULL;
+  cosmo->data.tab_E = NULL;
+  cosmo->data.tab_achi = NULL;
 
   cosmo->data.logsigma = NULL;
   cosmo->data.dlnsigma_dlogm = NULL;
+  cosmo->data.tab_logsigma = NULL;
+  cosmo->data.tab_dlnsigma_dlogm = NULL;
 
   // hmf parameter for interpolation
   cosmo->data.alphahmf = NULL;
@@ -195,6 +203,8 @@ ccl_cosmology * ccl_cosmology_create(ccl_parameters params, ccl_configuration co
 
   cosmo->data.p_lin = NULL;
   cosmo->data.p_nl = NULL;
+  cosmo->data.tab_p_lin = NULL;
+  cosmo->data.tab_p_nl = NULL;
   //cosmo->data.nu_pspace_int = NULL;
   cosmo->computed_distances = false;
   cosmo->computed_growth = false;
@@ -762,22 +772,26 @@ void ccl_data_free(ccl_data * data)
   gsl_spline_free(data->chi);
   gsl_spline_free(data->growth);
   gsl_spline_free(data->fgrowth);
-  gsl_interp_accel_free(data->accelerator);
-  gsl_interp_accel_free(data->accelerator_achi);
   gsl_spline_free(data->E);
   gsl_spline_free(data->achi);
   gsl_spline_free(data->logsigma);
   gsl_spline_free(data->dlnsigma_dlogm);
   gsl_spline2d_free(data->p_lin);
   gsl_spline2d_free(data->p_nl);
+  ccl_table1d_free(data->tab_chi);
+  ccl_table1d_free(data->tab_growth);
+  ccl_table1d_free(data->tab_fgrowth);
+  ccl_table1d_free(data->tab_E);
+  ccl_table1d_free(data->tab_achi);
+  ccl_table1d_free(data->tab_logsigma);
+  ccl_table1d_free(data->tab_dlnsigma_dlogm);
+  ccl_table2d_free(data->tab_p_lin);
+  ccl_table2d_free(data->tab_p_nl);
   gsl_spline_free(data->alphahmf);
   gsl_spline_free(data->betahmf);
   gsl_spline_free(data->gammahmf);
   gsl_spline_free(data->phihmf);
   gsl_spline_free(data->etahmf);
-  gsl_interp_accel_free(data->accelerator_d);
-  gsl_interp_accel_free(data->accelerator_m);
-  gsl_interp_accel_free(data->accelerator_k);
 }
 
 /* ------- ROUTINE: ccl_cosmology_set_status_message --------
@@ -789,11 +803,31 @@ void ccl_cosmology_set_status_message(ccl_cosmology * cosmo, const char * messag
   const int trunc = 480; /* must be < 500 - 4 */
   va_list va;
   va_start(va, message);
-  vsnprintf(cosmo->status_message, trunc, message, va);
+  /* Messages may be set concurrently from parallel regions */
+#pragma omp critical(ccl_status_message)
+  {
+    vsnprintf(cosmo->status_message, trunc, message, va);
+
+    /* if truncation happens, message[trunc - 1] is not NULL, ... will show up. */
+    strcpy(&cosmo->status_message[trunc], "...");
+  }
   va_end(va);
+}
 
-  /* if truncation happens, message[trunc - 1] is not NULL, ... will show up. */
-  strcpy(&cosmo->status_message[trunc], "...");
+/* ------- ROUTINE: ccl_cosmology_num_threads ------
+INPUT: ccl_cosmology * cosmo
+TASK: number of threads used by the parallel loops in CCL: config.n_threads if set,
+      the OpenMP default otherwise.
+*/
+int ccl_cosmology_num_threads(ccl_cosmology * cosmo)
+{
+#ifdef _OPENMP
+  if (cosmo->config.n_threads > 0)
+    return cosmo->config.n_threads;
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
 }
 
 /* ------- ROUTINE: ccl_parameters_free --------
@@ -466,8 +466,7 @@ void ccl_correlation_3d(ccl_cosmology *cosmo, double a,
     return;
   }  
 
-  for (i=0; i<N_ARR; i++)
-    pk_arr[i] = ccl_nonlin_matter_power(cosmo, k_arr[i], a, status);
+  ccl_nonlin_matter_powers_at_a(cosmo, a, N_ARR, k_arr, pk_arr, status);
 
   if (do_taper_pk)
     taper_cl(N_ARR,k_arr,pk_arr,taper_pk_limits);
@@ -12,7 +12,7 @@
 #include <string.h>
 
 #include <gsl/gsl_matrix.h>
-#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_blas.h>
 #include <gsl/gsl_spline.h>
 #include <gsl/gsl_errno.h>
 
@@ -21,148 +21,23 @@
 #include "ccl_emu17_params.h"
 #include "ccl_emu17.h"
 
-// Sizes of stuff
-static int m[2] = {111, 36}, neta=2808, peta[2]={7, 28}, rs=8, p=8;
-
-// Kriging basis computed by emuInit
-// Sizes of each basis will be peta[ee] and m[ee]
-static double KrigBasis[2][28][111];
+#include "ccl_emu17_krig.h"
 
-// Need to combine some things into a big thing.
-static double beta[2][28][8];
-static double w[2][28][111];
-static double lamws[2][28];
-static double lamz[2][28];
-
-// Initialization to compute the kriging basis for the two parts
-static void emuInit() {
-   
-    int ee, i, j, k, l;
-    double cov;
-    gsl_matrix *SigmaSim;
-    gsl_vector *b;
+// Sizes of stuff
+static const int m[2] = {111, 36}, neta=2808, peta[2]={7, 28}, rs=8, p=8;
 
-    // Because of the structure of this emu, I need to do this horrible part first.
-    // Fill in the correlation lenghths
-    for(i=0; i<7; i++) {
-        for(j=0; j<8; j++) {
-            beta[0][i][j] = beta1[i][j];
-        }
-    }
-    
-    for(i=0; i<28; i++) {
-        for(j=0; j<8; j++) {
-            beta[1][i][j] = beta2[i][j];
-        }
-    }
-    
-    // Fill in the PC weights
-    for(i=0; i<7; i++) {
-        for(j=0; j<111; j++) {
-            w[0][i][j] = w1[i][j];
-        }
-    }
-    
-    for(i=0; i<28; i++) {
-        for(j=0; j<36; j++) {
-            w[1][i][j] = w2[i][j];
-        }
-    }
-    
-    // Fill in the precisions
-    for(i=0; i<7; i++) {
-        lamws[0][i] = lamws1[i];
-        lamz[0][i] = lamz1[i];
-    }
-    
-    for(i=0; i<28; i++) {
-        lamws[1][i] = lamws2[i];
-        lamz[1][i] = lamz2[i];
-    }
-    
-    // This emu has two parts: one that uses all m[0] of the data for the the first peta[0] components
-    // and another that uses only the m[1] complete data for the next peta[1] components.
-    for(ee=0; ee<2; ee++) {
-        
-        // Allocate some stuff
-        SigmaSim = gsl_matrix_alloc(m[ee], m[ee]);
-        b = gsl_vector_alloc(m[ee]);
-        
-        // Loop over the basis
-        for(i=0; i<peta[ee]; i++) {
-            
-            // Loop over the number of simulations
-            for(j=0; j<m[ee]; j++) {
-                
-                // Diagonal term
-                gsl_matrix_set(SigmaSim, j, j, (1.0/lamz[ee][i]) + (1.0/lamws[ee][i]));
-                
-                // Off-diagonals
-                for(k=0; k<j; k++) {
-                    
-                    // compute the covariance
-                    cov = 0.0;
-                    for(l=0; l<p; l++) {
-                        cov -= beta[ee][i][l]*pow(x[j][l] - x[k][l], 2.0);
-                    } // for(l=0; l<p; l++)
-                    cov = exp(cov) / lamz[ee][i];
-                    
-                    // put the covariance where it belongs
-                    gsl_matrix_set(SigmaSim, j, k, cov);
-                    gsl_matrix_set(SigmaSim, k, j, cov);
-                    
-                } // for(k=0; k<j; k++)
-                
-                // Vector for the PC weights
-                gsl_vector_set(b, j, w[ee][i][j]);
-                
-            } // for(j=0; j<m[ee]; j++)
-            
-            // Cholesky and solve
-            gsl_linalg_cholesky_decomp(SigmaSim);
-            gsl_linalg_cholesky_svx(SigmaSim, b);
-            
-            // Put b where it belongs in the Kriging basis
-            for(j=0; j<m[ee]; j++) {
-                KrigBasis[ee][i][j] = gsl_vector_get(b, j);
-            }
-            
-        } // for(i=0; i<peta[ee]; i++)
-        
-        // Clean this up
-        gsl_matrix_free(SigmaSim);
-        gsl_vector_free(b);
-        
-    } // for(ee=0; ee<2; ee+)
-    
-} // emuInit()
+// The kriging basis (KrigBasis), together with the correlation lengths (beta)
+// and precisions (lamz) it is used with, is computed from ccl_emu17_params.h
+// at build time by ccl_emu17_krig_gen, and stored as constant arrays in
+// ccl_emu17_krig.h. The emulator therefore has no mutable global state.
 
-// Actual emulation
-void ccl_pkemu(double *xstar, double **ystar, int* status, ccl_cosmology* cosmo) {
-    
-    static double inited=0;
-    int ee, i, j, k;
-    double wstar[peta[0]+peta[1]];
-    double Sigmastar[2][peta[1]][m[0]];
-    double ystaremu[neta];
-    *ystar=(double *)malloc(sizeof(double)*NK_EMU);
-    double ybyz[rs];
-    double logc;
-    double xstarstd[p];
-    int zmatch;
-    gsl_spline *zinterp = gsl_spline_alloc(gsl_interp_cspline, rs);
-    gsl_interp_accel *accel = gsl_interp_accel_alloc();
-    
+// Check that the cosmological parameters are within the emulator bounds.
+// xstar contains the p cosmological parameters, with w_a already transformed
+// into (-w_0-w_a)^(1/4).
+static int emuCheckParams(double *xstar, int *status, ccl_cosmology *cosmo) {
     
-    // Initialize if necessary
-    if(inited==0) {
-        emuInit();
-        inited = 1;
-    }
+    int i;
     
-    // Transform w_a into (-w_0-w_a)^(1/4)
-    xstar[6] = pow(-xstar[5]-xstar[6], 0.25);
-    // Check the inputs to make sure we're interpolating.
     for(i=0; i<p; i++) {
         if((xstar[i] < xmin[i]) || (xstar[i] > xmax[i])) {
             switch(i) {
@@ -209,111 +84,231 @@ void ccl_pkemu(double *xstar, double **ystar, int* status, ccl_cosmology* cosmo)
             }
             *status = CCL_ERROR_EMULATOR_BOUND;
             ccl_raise_exception(*status, cosmo->status_message);
-	    gsl_spline_free(zinterp);
-	    gsl_interp_accel_free(accel);
-            return;
+            return 1;
         }
     } // for(i=0; i<p; i++)
-    if((xstar[p] < z[0]) || (xstar[p] > z[rs-1])) {
-        ccl_cosmology_set_status_message(cosmo, 
-                "ccl_pkemu(): z must be between %f and %f.\n", 
-                z[0], z[rs-1]);
-        *status = CCL_ERROR_EMULATOR_BOUND;
-        ccl_raise_exception(*status, cosmo->status_message);
-	gsl_spline_free(zinterp);
-	gsl_interp_accel_free(accel);
-        return;
-    }
     
-    // Standardize the inputs
-    for(i=0; i<p; i++) {
-        xstarstd[i] = (xstar[i] - xmin[i]) / xrange[i];
+    return 0;
+} // emuCheckParams()
+
+// Emulate log10 of the scaled spectrum at all the training redshifts for nc
+// cosmologies. This is the part of the emulation that only depends on the cosmology.
+// xstd contains the nc standardized inputs (nc x p). On output, ystaremu (neta x nc)
+// contains the emulated spectra, one cosmology per column.
+// The squared distances between inputs and simulations are expanded as
+// |x_j|^2 + |x*_c|^2 - 2 x_j.x*_c (weighted by beta), so that the covariances for
+// all cosmologies are obtained from one matrix product per PC, and the projection
+// onto the PC basis is a single matrix product for all cosmologies.
+// Returns GSL_ENOMEM if the work arrays can't be allocated, or the status of the
+// first BLAS call that failed.
+static int emuTrainingZ(int nc, double *xstd, double *ystaremu) {
+    
+    int ee, i, j, k, c;
+    int npc = peta[0]+peta[1];
+    int gslstatus = GSL_SUCCESS, s;
+    double *wstar = malloc(npc*nc*sizeof(double));
+    double *Sigmastar = malloc(nc*m[0]*sizeof(double));
+    double *bx = malloc(p*m[0]*sizeof(double));
+    double *ax = malloc(m[0]*sizeof(double));
+    if((wstar == NULL) || (Sigmastar == NULL) || (bx == NULL) || (ax == NULL)) {
+        free(wstar); free(Sigmastar); free(bx); free(ax);
+        return GSL_ENOMEM;
     }
+    gsl_matrix_view xstd_m = gsl_matrix_view_array(xstd, nc, p);
     
-    // compute the covariances between the new input and sims for all the PCs.
+    // compute the covariances between the new inputs and sims for all the PCs,
+    // and the PC weights wstar (npc x nc).
+    int ipc = 0;
     for(ee=0; ee<2; ee++) {
-        for(i=0; i<peta[ee]; i++) {
+        gsl_matrix_view bx_m = gsl_matrix_view_array(bx, p, m[ee]);
+        gsl_matrix_view Sigmastar_m = gsl_matrix_view_array(Sigmastar, nc, m[ee]);
+        for(i=0; i<peta[ee]; i++, ipc++) {
             for(j=0; j<m[ee]; j++) {
-                logc = 0.0;
+                ax[j] = 0.0;
                 for(k=0; k<p; k++) {
-                    logc -= beta[ee][i][k]*pow(x[j][k] - xstarstd[k], 2.0);
+                    ax[j] += beta[ee][i][k]*x[j][k]*x[j][k];
+                    bx[k*m[ee]+j] = beta[ee][i][k]*x[j][k];
                 }
-                Sigmastar[ee][i][j] = exp(logc) / lamz[ee][i];
             }
+            
+            s = gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &xstd_m.matrix, &bx_m.matrix,
+                               0.0, &Sigmastar_m.matrix);
+            if(gslstatus == GSL_SUCCESS) gslstatus = s;
+            
+            for(c=0; c<nc; c++) {
+                double bc = 0.0;
+                for(k=0; k<p; k++) {
+                    bc += beta[ee][i][k]*xstd[c*p+k]*xstd[c*p+k];
+                }
+                for(j=0; j<m[ee]; j++) {
+                    double logc = 2*Sigmastar[c*m[ee]+j] - ax[j] - bc;
+                    if(logc > 0.0) logc = 0.0; // Round-off
+                    Sigmastar[c*m[ee]+j] = exp(logc) / lamz[ee][i];
+                }
+            }
+            
+            gsl_vector_const_view krig_v = gsl_vector_const_view_array(&(KrigBasis[ee][i][0]), m[ee]);
+            gsl_vector_view wstar_v = gsl_vector_view_array(&(wstar[ipc*nc]), nc);
+            s = gsl_blas_dgemv(CblasNoTrans, 1.0, &Sigmastar_m.matrix, &krig_v.vector,
+                               0.0, &wstar_v.vector);
+            if(gslstatus == GSL_SUCCESS) gslstatus = s;
         }
     }
     
-    // Compute wstar for the first chunk.
-    for(i=0; i<peta[0]; i++) {
-        wstar[i]=0.0;
-        for(j=0; j<m[0]; j++) {
-            wstar[i] += Sigmastar[0][i][j] * KrigBasis[0][i][j];
+    // Compute ystar, the new output
+    gsl_matrix_const_view K_m = gsl_matrix_const_view_array(&(K[0][0]), neta, npc);
+    gsl_matrix_view wstar_m = gsl_matrix_view_array(wstar, npc, nc);
+    gsl_matrix_view ystaremu_m = gsl_matrix_view_array(ystaremu, neta, nc);
+    s = gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &K_m.matrix, &wstar_m.matrix,
+                       0.0, &ystaremu_m.matrix);
+    if(gslstatus == GSL_SUCCESS) gslstatus = s;
+    for(i=0; i<neta; i++) {
+        for(c=0; c<nc; c++) {
+            ystaremu[i*nc+c] = ystaremu[i*nc+c]*sd + mean[i];
         }
     }
-    // Compute wstar for the second chunk.
-    for(i=0; i<peta[1]; i++) {
-        wstar[peta[0]+i]=0.0;
-        for(j=0; j<m[1]; j++) {
-            wstar[peta[0]+i] += Sigmastar[1][i][j] * KrigBasis[1][i][j];
+    
+    free(wstar); free(Sigmastar); free(bx); free(ax);
+    return gslstatus;
+} // emuTrainingZ()
+
+// Emulation for several cosmologies at several redshifts
+void ccl_pkemu_batch(int ncosmo, double *xstarin, int nz, double *zstar, double *Pkemu, int *status, ccl_cosmology *cosmo) {
+    
+    int i, j, iz, c;
+    double ybyz[rs];
+    
+    for(iz=0; iz<nz; iz++) {
+        if((zstar[iz] < z[0]) || (zstar[iz] > z[rs-1])) {
+            ccl_cosmology_set_status_message(cosmo, 
+                    "ccl_pkemu(): z must be between %f and %f.\n", 
+                    z[0], z[rs-1]);
+            *status = CCL_ERROR_EMULATOR_BOUND;
+            ccl_raise_exception(*status, cosmo->status_message);
+            return;
         }
     }
     
-    /*
-    for(i=0; i<peta[0]+peta[1]; i++) {
-        printf("%f\n", wstar[i]);
+    double *xstd = malloc(ncosmo*p*sizeof(double));
+    double *ystaremu = malloc(neta*ncosmo*sizeof(double));
+    int *zmatch = malloc(nz*sizeof(int));
+    int *outside = malloc(ncosmo*sizeof(int));
+    gsl_spline *zinterp = gsl_spline_alloc(gsl_interp_cspline, rs);
+    gsl_interp_accel *accel = gsl_interp_accel_alloc();
+    if((xstd == NULL) || (ystaremu == NULL) || (zmatch == NULL) || (outside == NULL) ||
+       (zinterp == NULL) || (accel == NULL)) {
+        free(xstd); free(ystaremu); free(zmatch); free(outside);
+        if(zinterp != NULL) gsl_spline_free(zinterp);
+        if(accel != NULL) gsl_interp_accel_free(accel);
+        *status = CCL_ERROR_MEMORY;
+        ccl_cosmology_set_status_message(cosmo, "ccl_pkemu(): memory allocation error\n");
+        return;
     }
-     */
     
-    // Compute ystar, the new output
-    for(i=0; i<neta; i++) {
-        ystaremu[i] = 0.0;
-        for(j=0; j<peta[0]+peta[1]; j++) {
-            ystaremu[i] += K[i][j]*wstar[j];
+    for(c=0; c<ncosmo; c++) {
+        double xstar[p];
+        
+        // Transform w_a into (-w_0-w_a)^(1/4)
+        for(i=0; i<p; i++) {
+            xstar[i] = xstarin[c*p+i];
+        }
+        xstar[6] = pow(-xstar[5]-xstar[6], 0.25);
+        // Check the inputs to make sure we're interpolating.
+        // A cosmology outside the bounds only invalidates its own spectra: it is
+        // emulated at the centre of the parameter space and its output set to NAN.
+        outside[c] = emuCheckParams(xstar, status, cosmo);
+        
+        // Standardize the inputs
+        for(i=0; i<p; i++) {
+            xstd[c*p+i] = outside[c] ? 0.5 : (xstar[i] - xmin[i]) / xrange[i];
         }
-        ystaremu[i] = ystaremu[i]*sd + mean[i];
-                
-        // Convert to P(k)
-        //ystaremu[i] = ystaremu[i] - 1.5*log10(mode[i % NK_EMU]);
-        //ystaremu[i] = 2*M_PI*M_PI*pow(10, ystaremu[i]);
     }
     
+    // The cosmology-dependent part is done only once for all redshifts
+    int gslstatus = emuTrainingZ(ncosmo, xstd, ystaremu);
+    if(gslstatus != GSL_SUCCESS) {
+        free(xstd); free(ystaremu); free(zmatch); free(outside);
+        gsl_spline_free(zinterp);
+        gsl_interp_accel_free(accel);
+        if(gslstatus == GSL_ENOMEM) {
+            *status = CCL_ERROR_MEMORY;
+            ccl_cosmology_set_status_message(cosmo, "ccl_pkemu(): memory allocation error\n");
+        }
+        else {
+            ccl_raise_gsl_warning(gslstatus, "ccl_emu17.c: ccl_pkemu_batch():");
+            *status = CCL_ERROR_EMULATOR;
+            ccl_cosmology_set_status_message(cosmo, "ccl_pkemu(): error computing the emulator PC weights\n");
+        }
+        return;
+    }
     
-    
-    // Interpolate to the desired redshift
-    // Natural cubic spline interpolation over z.
-    
-    // First check to see if the requested z is one of the training z.
-    zmatch = -1;
-    for(i=0; i<rs; i++) {
-        if(xstar[p] == z[i]) {
-            zmatch = rs-i-1;
+    // Check to see if the requested z are some of the training z.
+    for(iz=0; iz<nz; iz++) {
+        zmatch[iz] = -1;
+        for(i=0; i<rs; i++) {
+            if(zstar[iz] == z[i]) {
+                zmatch[iz] = rs-i-1;
+            }
         }
     }
     
-    // z doesn't match a training z, interpolate
-    if(zmatch == -1) {
+    // Interpolate to the desired redshifts
+    // Natural cubic spline interpolation over z, built once per cosmology and k.
+    for(c=0; c<ncosmo; c++) {
+        double *pk = &(Pkemu[c*nz*NK_EMU]);
         for(i=0; i<NK_EMU; i++) {
             for(j=0; j<rs; j++) {
-                ybyz[rs-j-1] = ystaremu[j*NK_EMU+i];
+                ybyz[rs-j-1] = ystaremu[(j*NK_EMU+i)*ncosmo+c];
             }
             gsl_spline_init(zinterp, z, ybyz, rs);
-            (*ystar)[i] = gsl_spline_eval(zinterp, xstar[p], accel);
             gsl_interp_accel_reset(accel);
-        }
-        
-    } else { //otherwise, copy in the emulated z without interpolating
-        for(i=0; i<NK_EMU; i++) {
-	  (*ystar)[i] = ystaremu[zmatch*NK_EMU + i];
+            for(iz=0; iz<nz; iz++) {
+                if(zmatch[iz] == -1) {
+                    pk[iz*NK_EMU+i] = gsl_spline_eval(zinterp, zstar[iz], accel);
+                } else { //otherwise, copy in the emulated z without interpolating
+                    pk[iz*NK_EMU+i] = ystaremu[(zmatch[iz]*NK_EMU + i)*ncosmo+c];
+                }
+            }
         }
     }
     
     gsl_spline_free(zinterp);
     gsl_interp_accel_free(accel);
-	
+    free(xstd); free(ystaremu); free(zmatch);
+    
     // Convert to P(k)
-    for(i=0; i<NK_EMU; i++) {
-      (*ystar)[i] = (*ystar)[i] - 1.5*log10(mode[i]) + log10(2) + 2*log10(M_PI);
-      (*ystar)[i] = pow(10, (*ystar)[i]);
+    for(c=0; c<ncosmo*nz; c++) {
+        for(i=0; i<NK_EMU; i++) {
+            Pkemu[c*NK_EMU+i] = Pkemu[c*NK_EMU+i] - 1.5*log10(mode[i]) + log10(2) + 2*log10(M_PI);
+            Pkemu[c*NK_EMU+i] = pow(10, Pkemu[c*NK_EMU+i]);
+        }
     }
+    
+    for(c=0; c<ncosmo; c++) {
+        if(outside[c]) {
+            for(i=0; i<nz*NK_EMU; i++) {
+                Pkemu[c*nz*NK_EMU+i] = NAN;
+            }
+        }
+    }
+    free(outside);
+}
+
+// Emulation at several redshifts
+void ccl_pkemu_multiz(double *xstarin, int nz, double *zstar, double *Pkemu, int *status, ccl_cosmology *cosmo) {
+    
+    ccl_pkemu_batch(1, xstarin, nz, zstar, Pkemu, status, cosmo);
 }
 
+// Actual emulation
+void ccl_pkemu(double *xstar, double **ystar, int* status, ccl_cosmology* cosmo) {
+    
+    *ystar=(double *)malloc(sizeof(double)*NK_EMU);
+    if(*ystar == NULL) {
+        *status = CCL_ERROR_MEMORY;
+        ccl_cosmology_set_status_message(cosmo, "ccl_pkemu(): memory allocation error\n");
+        return;
+    }
+    
+    ccl_pkemu_multiz(xstar, 1, &(xstar[p]), *ystar, status, cosmo);
+}
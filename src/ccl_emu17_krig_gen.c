@@ -0,0 +1,187 @@
+//
+//  Build-time generator for the Cosmic Emulator kriging basis.
+//  Computes the kriging basis from the emulator design in ccl_emu17_params.h
+//  and writes it, together with the correlation lengths and precisions it is
+//  used with, as constant arrays to the header given as argument.
+//  For details on the license, see ../LICENSE_COSMICEMU
+//  in this repository.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+
+#include "ccl_defs.h"
+#include "ccl_emu17_params.h"
+
+// Sizes of stuff
+#define EMU_NPARTS 2
+#define EMU_PETA_MAX 28
+#define EMU_M_MAX 111
+#define EMU_P 8
+static const int m[EMU_NPARTS] = {111, 36}, peta[EMU_NPARTS]={7, 28};
+
+static double KrigBasis[EMU_NPARTS][EMU_PETA_MAX][EMU_M_MAX];
+static double beta[EMU_NPARTS][EMU_PETA_MAX][EMU_P];
+static double w[EMU_NPARTS][EMU_PETA_MAX][EMU_M_MAX];
+static double lamws[EMU_NPARTS][EMU_PETA_MAX];
+static double lamz[EMU_NPARTS][EMU_PETA_MAX];
+
+// Compute the kriging basis for the two parts
+static int emuInit(void) {
+
+    int ee, i, j, k, l;
+    double cov;
+    int gslstatus = 0;
+    gsl_matrix *SigmaSim;
+    gsl_vector *b;
+
+    // Because of the structure of this emu, I need to do this horrible part first.
+    // Fill in the correlation lenghths
+    for(i=0; i<7; i++) {
+        for(j=0; j<EMU_P; j++) {
+            beta[0][i][j] = beta1[i][j];
+        }
+    }
+
+    for(i=0; i<28; i++) {
+        for(j=0; j<EMU_P; j++) {
+            beta[1][i][j] = beta2[i][j];
+        }
+    }
+
+    // Fill in the PC weights
+    for(i=0; i<7; i++) {
+        for(j=0; j<111; j++) {
+            w[0][i][j] = w1[i][j];
+        }
+    }
+
+    for(i=0; i<28; i++) {
+        for(j=0; j<36; j++) {
+            w[1][i][j] = w2[i][j];
+        }
+    }
+
+    // Fill in the precisions
+    for(i=0; i<7; i++) {
+        lamws[0][i] = lamws1[i];
+        lamz[0][i] = lamz1[i];
+    }
+
+    for(i=0; i<28; i++) {
+        lamws[1][i] = lamws2[i];
+        lamz[1][i] = lamz2[i];
+    }
+
+    // This emu has two parts: one that uses all m[0] of the data for the the first peta[0] components
+    // and another that uses only the m[1] complete data for the next peta[1] components.
+    for(ee=0; ee<EMU_NPARTS; ee++) {
+
+        // Allocate some stuff
+        SigmaSim = gsl_matrix_alloc(m[ee], m[ee]);
+        b = gsl_vector_alloc(m[ee]);
+
+        // Loop over the basis
+        for(i=0; i<peta[ee]; i++) {
+
+            // Loop over the number of simulations
+            for(j=0; j<m[ee]; j++) {
+
+                // Diagonal term
+                gsl_matrix_set(SigmaSim, j, j, (1.0/lamz[ee][i]) + (1.0/lamws[ee][i]));
+
+                // Off-diagonals
+                for(k=0; k<j; k++) {
+
+                    // compute the covariance
+                    cov = 0.0;
+                    for(l=0; l<EMU_P; l++) {
+                        cov -= beta[ee][i][l]*pow(x[j][l] - x[k][l], 2.0);
+                    } // for(l=0; l<EMU_P; l++)
+                    cov = exp(cov) / lamz[ee][i];
+
+                    // put the covariance where it belongs
+                    gsl_matrix_set(SigmaSim, j, k, cov);
+                    gsl_matrix_set(SigmaSim, k, j, cov);
+
+                } // for(k=0; k<j; k++)
+
+                // Vector for the PC weights
+                gsl_vector_set(b, j, w[ee][i][j]);
+
+            } // for(j=0; j<m[ee]; j++)
+
+            // Cholesky and solve
+            gslstatus |= gsl_linalg_cholesky_decomp(SigmaSim);
+            gslstatus |= gsl_linalg_cholesky_svx(SigmaSim, b);
+
+            // Put b where it belongs in the Kriging basis
+            for(j=0; j<m[ee]; j++) {
+                KrigBasis[ee][i][j] = gsl_vector_get(b, j);
+            }
+
+        } // for(i=0; i<peta[ee]; i++)
+
+        // Clean this up
+        gsl_matrix_free(SigmaSim);
+        gsl_vector_free(b);
+
+    } // for(ee=0; ee<2; ee+)
+
+    return gslstatus;
+} // emuInit()
+
+// Write a flat array of n doubles with enough digits to round-trip exactly
+static void write_array(FILE *f, const char *decl, const double *arr, int n) {
+
+    fprintf(f, "%s = {\n", decl);
+    for(int i=0; i<n; i++) {
+        fprintf(f, "%.17g%s", arr[i], (i<n-1) ? "," : "");
+        if((i%4 == 3) || (i == n-1))
+            fprintf(f, "\n");
+    }
+    fprintf(f, "};\n\n");
+}
+
+int main(int argc, char **argv) {
+
+    if(argc != 2) {
+        fprintf(stderr, "Usage: %s <output header>\n", argv[0]);
+        return 1;
+    }
+
+    gsl_set_error_handler_off();
+    if(emuInit()) {
+        fprintf(stderr, "%s: error computing the kriging basis\n", argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "w");
+    if(f == NULL) {
+        fprintf(stderr, "%s: can't open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    fprintf(f, "// Generated by ccl_emu17_krig_gen from ccl_emu17_params.h. Do not edit.\n");
+    fprintf(f, "#ifndef __CCL_EMU17_KRIG_H_INCLUDED__\n");
+    fprintf(f, "#define __CCL_EMU17_KRIG_H_INCLUDED__\n\n");
+    write_array(f, "static const double KrigBasis[2][28][111]", &(KrigBasis[0][0][0]),
+                EMU_NPARTS*EMU_PETA_MAX*EMU_M_MAX);
+    write_array(f, "static const double beta[2][28][8]", &(beta[0][0][0]),
+                EMU_NPARTS*EMU_PETA_MAX*EMU_P);
+    write_array(f, "static const double lamz[2][28]", &(lamz[0][0]),
+                EMU_NPARTS*EMU_PETA_MAX);
+    fprintf(f, "#endif\n");
+
+    if(fclose(f)) {
+        fprintf(stderr, "%s: error writing %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -135,8 +135,6 @@ static void ccl_cosmology_compute_hmfparams(ccl_cosmology *cosmo, int *status)
       ccl_cosmology_set_status_message(cosmo, "ccl_massfunc.c: ccl_cosmology_compute_hmfparams(): Error creating eta(D) spline\n");
       return;
     }
-    if(cosmo->data.accelerator_d==NULL)
-      cosmo->data.accelerator_d=gsl_interp_accel_alloc();
     cosmo->data.alphahmf = alphahmf;
     cosmo->data.betahmf = betahmf;
     cosmo->data.gammahmf = gammahmf;
@@ -202,8 +200,6 @@ static void ccl_cosmology_compute_hmfparams(ccl_cosmology *cosmo, int *status)
       return;
     }
 
-    if(cosmo->data.accelerator_d==NULL)
-      cosmo->data.accelerator_d=gsl_interp_accel_alloc();
     cosmo->data.alphahmf = alphahmf;
     cosmo->data.betahmf = betahmf;
     cosmo->data.gammahmf = gammahmf;
@@ -278,10 +274,10 @@ static double massfunc_f(ccl_cosmology *cosmo, double halomass, double a, double
       ccl_cosmology_compute_hmfparams(cosmo, status);
       ccl_check_status(cosmo, status);
     }
-    gslstatus = gsl_spline_eval_e(cosmo->data.alphahmf, log10(odelta), cosmo->data.accelerator_d,&fit_A);
-    gslstatus |= gsl_spline_eval_e(cosmo->data.betahmf, log10(odelta), cosmo->data.accelerator_d,&fit_a);
-    gslstatus |= gsl_spline_eval_e(cosmo->data.gammahmf, log10(odelta), cosmo->data.accelerator_d,&fit_b);
-    gslstatus |= gsl_spline_eval_e(cosmo->data.phihmf, log10(odelta), cosmo->data.accelerator_d,&fit_c);
+    gslstatus = gsl_spline_eval_e(cosmo->data.alphahmf, log10(odelta), NULL,&fit_A);
+    gslstatus |= gsl_spline_eval_e(cosmo->data.betahmf, log10(odelta), NULL,&fit_a);
+    gslstatus |= gsl_spline_eval_e(cosmo->data.gammahmf, log10(odelta), NULL,&fit_b);
+    gslstatus |= gsl_spline_eval_e(cosmo->data.phihmf, log10(odelta), NULL,&fit_c);
     fit_d = pow(10, -1.0*pow(0.75 / log10(odelta / 75.0), 1.2));
 
     fit_A = fit_A*pow(a, 0.14);
@@ -314,11 +310,11 @@ static double massfunc_f(ccl_cosmology *cosmo, double halomass, double a, double
     delta_c_Tinker = 1.686;
     nu = delta_c_Tinker/(sigma);
 
-    gslstatus = gsl_spline_eval_e(cosmo->data.alphahmf, log10(odelta), cosmo->data.accelerator_d,&fit_A); //alpha in Eq. 8
-    gslstatus |= gsl_spline_eval_e(cosmo->data.etahmf, log10(odelta), cosmo->data.accelerator_d,&fit_a); //eta in Eq. 8
-    gslstatus |= gsl_spline_eval_e(cosmo->data.betahmf, log10(odelta), cosmo->data.accelerator_d,&fit_b); //beta in Eq. 8
-    gslstatus |= gsl_spline_eval_e(cosmo->data.gammahmf, log10(odelta), cosmo->data.accelerator_d,&fit_c); //gamma in Eq. 8
-    gslstatus |= gsl_spline_eval_e(cosmo->data.phihmf, log10(odelta), cosmo->data.accelerator_d,&fit_d); //phi in Eq. 8;
+    gslstatus = gsl_spline_eval_e(cosmo->data.alphahmf, log10(odelta), NULL,&fit_A); //alpha in Eq. 8
+    gslstatus |= gsl_spline_eval_e(cosmo->data.etahmf, log10(odelta), NULL,&fit_a); //eta in Eq. 8
+    gslstatus |= gsl_spline_eval_e(cosmo->data.betahmf, log10(odelta), NULL,&fit_b); //beta in Eq. 8
+    gslstatus |= gsl_spline_eval_e(cosmo->data.gammahmf, log10(odelta), NULL,&fit_c); //gamma in Eq. 8
+    gslstatus |= gsl_spline_eval_e(cosmo->data.phihmf, log10(odelta), NULL,&fit_d); //phi in Eq. 8;
 
     fit_a *=pow(a, -0.27);
     fit_b *=pow(a, -0.20);
@@ -444,8 +440,8 @@ void ccl_cosmology_compute_sigma(ccl_cosmology *cosmo, int *status)
 
   // start up of GSL pointers
   int gslstatus = 0;
-  gsl_spline *logsigma;
-  gsl_spline *dlnsigma_dlogm;
+  gsl_spline *logsigma=NULL;
+  gsl_spline *dlnsigma_dlogm=NULL;
 
   if (m==NULL ||
       (fabs(m[0]-ccl_splines->LOGM_SPLINE_MIN)>1e-5) ||
@@ -506,8 +502,6 @@ void ccl_cosmology_compute_sigma(ccl_cosmology *cosmo, int *status)
   if(*status==0) {
     dlnsigma_dlogm = gsl_spline_alloc(M_SPLINE_TYPE, nm);
     *status = gsl_spline_init(dlnsigma_dlogm, m, y, nm);
-    if(cosmo->data.accelerator_m==NULL)
-      cosmo->data.accelerator_m=gsl_interp_accel_alloc();
   }
 
   if(*status!=0) {
@@ -516,15 +510,34 @@ void ccl_cosmology_compute_sigma(ccl_cosmology *cosmo, int *status)
   }
   
 
-  cosmo->data.logsigma = logsigma;
-  cosmo->data.dlnsigma_dlogm = dlnsigma_dlogm;
-  cosmo->computed_sigma = true;
+  ccl_table1d *tab_logsigma=NULL,*tab_dlnsigma_dlogm=NULL;
+  if(*status==0) {
+    tab_logsigma=ccl_table1d_new(logsigma);
+    tab_dlnsigma_dlogm=ccl_table1d_new(dlnsigma_dlogm);
+    if(tab_logsigma==NULL || tab_dlnsigma_dlogm==NULL) {
+      *status = CCL_ERROR_SPLINE ;
+      ccl_cosmology_set_status_message(cosmo, "ccl_massfunc.c: ccl_cosmology_compute_sigma(): Error creating sigma(M) tables\n");
+    }
+  }
 
   free(m);
   free(y);
-  if(*status != 0) {
-    gsl_spline_free(logsigma);
-    gsl_spline_free(dlnsigma_dlogm);
+
+  // Only hand the splines and tables over to the cosmology if all of them were built
+  if(*status == 0) {
+    cosmo->data.logsigma = logsigma;
+    cosmo->data.dlnsigma_dlogm = dlnsigma_dlogm;
+    cosmo->data.tab_logsigma = tab_logsigma;
+    cosmo->data.tab_dlnsigma_dlogm = tab_dlnsigma_dlogm;
+    cosmo->computed_sigma = true;
+  }
+  else {
+    if(logsigma!=NULL)
+      gsl_spline_free(logsigma);
+    if(dlnsigma_dlogm!=NULL)
+      gsl_spline_free(dlnsigma_dlogm);
+    ccl_table1d_free(tab_logsigma);
+    ccl_table1d_free(tab_dlnsigma_dlogm);
   }
   return;
 }
@@ -545,7 +558,7 @@ static double ccl_dlninvsig_dlogm(ccl_cosmology *cosmo, double halomass, int*sta
 
   logmass = log10(halomass);
 
-  int gslstatus = gsl_spline_eval_e(cosmo->data.dlnsigma_dlogm, logmass, cosmo->data.accelerator_m,&val);
+  int gslstatus = ccl_table1d_eval_e(cosmo->data.tab_dlnsigma_dlogm, logmass, &val);
   if(gslstatus != GSL_SUCCESS) {
     ccl_raise_gsl_warning(gslstatus, "ccl_massfunc.c: ccl_massfunc():");
     *status |= gslstatus;
@@ -638,9 +651,8 @@ double ccl_sigmaM(ccl_cosmology *cosmo, double halomass, double a, int *status)
 
   double lgsigmaM;
 
-  int gslstatus = gsl_spline_eval_e(cosmo->data.logsigma, 
-                                    log10(halomass), 
-                                    cosmo->data.accelerator_m,&lgsigmaM);
+  int gslstatus = ccl_table1d_eval_e(cosmo->data.tab_logsigma,
+                                     log10(halomass), &lgsigmaM);
 
   if(gslstatus != GSL_SUCCESS) {
     ccl_raise_gsl_warning(gslstatus, "ccl_massfunc.c: ccl_sigmaM():");
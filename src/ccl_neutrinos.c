@@ -93,8 +93,27 @@ TASK: Get the value of the phase space integral at mnuOT
 
 double nu_phasespace_intg(gsl_interp_accel* accel, double mnuOT, int* status)
 {
-  // Check if the global variable for the phasespace spline has been defined yet:
-  if (nu_spline==NULL) nu_spline =calculate_nu_phasespace_spline(status);
+  // Check if the global variable for the phasespace spline has been defined yet.
+  // This is done once per process. The pointer is only published once the spline
+  // is complete, and always read atomically, so concurrent callers never see a
+  // partially built spline.
+  gsl_spline *spl;
+#pragma omp atomic read
+  spl=nu_spline;
+#pragma omp flush
+  if (spl==NULL) {
+#pragma omp critical(ccl_nu_spline)
+    {
+#pragma omp atomic read
+      spl=nu_spline;
+      if (spl==NULL) {
+        spl=calculate_nu_phasespace_spline(status);
+#pragma omp flush
+#pragma omp atomic write
+        nu_spline=spl;
+      }
+    }
+  }
   ccl_check_status_nocosmo(status);
   
   double integral_value =0.;
@@ -107,8 +126,13 @@ double nu_phasespace_intg(gsl_interp_accel* accel, double mnuOT, int* status)
     return 0.2776566337*mnuOT; 
   }
 	
+  if (spl==NULL) {
+    if (*status==0) *status = CCL_ERROR_NU_INT;
+    return NAN;
+  }
+
   // Evaluate the spline - this will use the accelerator if it has been defined.
-  int gslstatus = gsl_spline_eval_e(nu_spline, log(mnuOT),accel, &integral_value);
+  int gslstatus = gsl_spline_eval_e(spl, log(mnuOT),accel, &integral_value);
   if(gslstatus != GSL_SUCCESS) {
     ccl_raise_gsl_warning(gslstatus, "ccl_neutrinos.c: nu_phasespace_intg():");
     *status |= gslstatus;
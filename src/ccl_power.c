@@ -14,7 +14,6 @@
 #include "ccl_emu17.h"
 #include "ccl_emu17_params.h"
 
-
 /*------ ROUTINE: ccl_cosmology_compute_power_class -----
 INPUT: ccl_cosmology * cosmo
 */
@@ -450,14 +449,16 @@ static void ccl_cosmology_compute_power_class(ccl_cosmology * cosmo, int * statu
   //Status flags
   int newstatus=0;
   int pwstatus=0;
+  int nthreads=ccl_cosmology_num_threads(cosmo);
   
   //If not, proceed
   if(!*status){
     
     // After this loop x will contain log(k)
     // all in Mpc, not Mpc/h units!
-    double psout_l,ic;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic) reduction(|:newstatus)
     for (int i=0; i<nk; i++) {
+      double psout_l,ic;
       for (int j = 0; j < na; j++) {
 	//The 2D interpolation routines access the function values y_{k_ia_j} with the following ordering:
 	//y_ij = y2d[j*N_k + i]
@@ -522,8 +523,9 @@ static void ccl_cosmology_compute_power_class(ccl_cosmology * cosmo, int * statu
     
     if(cosmo->config.matter_power_spectrum_method==ccl_halofit) {
 	
-      double psout_nl;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic) reduction(|:newstatus)
       for (int i=0; i<nk; i++) {
+	double psout_nl;
 	for (int j = 0; j < na; j++) {
 	  newstatus |= spectra_pk_nl_at_k_and_z(&ba, &pm, &sp,exp(x[i]),1./a[j]-1.,&psout_nl);
 	  y2d_nl[j*nk+i] = log(psout_nl);
@@ -837,6 +839,35 @@ static double eh_power(ccl_parameters *params,eh_struct *eh,double k,int wiggled
   double kinvh=k/params->h; //Changed to h/Mpc
   return pow(k,params->n_s)*tsqr_EH(params,eh,kinvh,wiggled);
 }
+/*------ ROUTINE: ccl_power_fill_growth -----
+INPUT: ccl_cosmology * cosmo, log(P(k)) at a=1 on nk wavenumbers, na scale factors
+TASK: fill the 2D table y2d[j*nk+i] = log(P(k_i)) + 2*log(D(a_j)) used by the
+      E&H and BBKS power spectra
+*/
+static void ccl_power_fill_growth(ccl_cosmology * cosmo, int nk, double *y, int na, double *a,
+				  double *y2d, int * status)
+{
+  double *gf = malloc(na*sizeof(double));
+  if (gf == NULL) {
+    *status = CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo, "ccl_power.c: ccl_power_fill_growth(): memory allocation error\n");
+    return;
+  }
+
+  ccl_growth_factors(cosmo, na, a, gf, status);
+  if (*status == 0) {
+#pragma omp parallel for num_threads(ccl_cosmology_num_threads(cosmo))
+    for (int j = 0; j < na; j++) {
+      double g2 = 2.*log(gf[j]);
+      for (int i=0; i<nk; i++) {
+	y2d[j*nk+i] = y[i]+g2;
+      } // end loop over k
+    } // end loop over a
+  }
+
+  free(gf);
+}
+
 static void ccl_cosmology_compute_power_eh(ccl_cosmology * cosmo, int * status)
 {
   //These are the limits of the splining range
@@ -892,21 +923,15 @@ static void ccl_cosmology_compute_power_eh(ccl_cosmology * cosmo, int * status)
   // Notice the last parameter in eh_power controls
   // whether to introduce wiggles (BAO) in the power spectrum.
   // We do this by default.
+#pragma omp parallel for num_threads(ccl_cosmology_num_threads(cosmo))
   for (int i=0; i<nk; i++) {
     y[i] = log(eh_power(&cosmo->params, eh, x[i], 1));
     x[i] = log(x[i]);
   }
 
   // Apply growth factor, D(a), to P(k) and store in 2D (k, a) array
-  double gfac, g2;
   gsl_spline2d *log_power_lin = gsl_spline2d_alloc(PLIN_SPLINE_TYPE, nk,na);
-  for (int j = 0; j < na; j++) {
-    gfac = ccl_growth_factor(cosmo, a[j], status); 
-    g2 = 2.*log(gfac);
-    for (int i=0; i<nk; i++) {
-      y2d[j*nk+i] = y[i]+g2;
-    } // end loop over k
-  } // end loop over a
+  ccl_power_fill_growth(cosmo, nk, y, na, a, y2d, status);
 
   // Check that ccl_growth_factor didn't fail
   if (*status) {
@@ -945,13 +970,7 @@ static void ccl_cosmology_compute_power_eh(ccl_cosmology * cosmo, int * status)
   for (int i=0; i < nk; i++) {
     y[i] += log_normalization_factor;
   }
-  for (int j = 0; j < na; j++) {
-    gfac = ccl_growth_factor(cosmo, a[j], status);
-    g2 = 2.*log(gfac);
-    for (int i=0; i<nk; i++) {
-      y2d[j*nk+i] = y[i]+g2; // Replace previous values
-    } // end k loop
-  } // end a loop
+  ccl_power_fill_growth(cosmo, nk, y, na, a, y2d, status); // Replace previous values
 
   splinstatus = gsl_spline2d_init(log_power_lin, x, a, y2d, nk, na);
   if (splinstatus) {
@@ -1049,19 +1068,14 @@ static void ccl_cosmology_compute_power_bbks(ccl_cosmology * cosmo, int * status
   }
 
   // After this loop x will contain log(k)
+#pragma omp parallel for num_threads(ccl_cosmology_num_threads(cosmo))
   for (int i=0; i<nk; i++) {
     y[i] = log(bbks_power(&cosmo->params, x[i]));
     x[i] = log(x[i]);
   }
 
   gsl_spline2d * log_power_lin = gsl_spline2d_alloc(PLIN_SPLINE_TYPE, nk,na);
-  for (int j = 0; j < na; j++) {
-    double gfac = ccl_growth_factor(cosmo,a[j], status);
-    double g2 = 2.*log(gfac);
-    for (int i=0; i<nk; i++) {
-      y2d[j*nk+i] = y[i]+g2;
-    }
-  }
+  ccl_power_fill_growth(cosmo, nk, y, na, a, y2d, status);
 
   // Check that ccl_growth_factor didn't fail
   if (*status) {
@@ -1101,13 +1115,7 @@ static void ccl_cosmology_compute_power_bbks(ccl_cosmology * cosmo, int * status
   for (int i=0; i<nk; i++) {
     y[i] += log_normalization_factor;
   }
-  for (int j = 0; j < na; j++) {
-    double gfac = ccl_growth_factor(cosmo,a[j], status);
-    double g2 = 2.*log(gfac);
-    for (int i=0; i<nk; i++) {
-      y2d[j*nk+i] = y[i]+g2;
-    }
-  }
+  ccl_power_fill_growth(cosmo, nk, y, na, a, y2d, status);
 
   splinstatus = gsl_spline2d_init(log_power_lin, x, a, y2d,nk,na);
   if (splinstatus) {
@@ -1206,7 +1214,7 @@ static void ccl_cosmology_compute_power_emu(ccl_cosmology * cosmo, int * status)
       }else if (cosmo->config.emulator_neutrinos_method == ccl_emu_equalize){
           // Reset the masses to equal
           double mnu_eq[3] = {cosmo->params.sum_nu_masses / 3., cosmo->params.sum_nu_masses / 3., cosmo->params.sum_nu_masses / 3.};
-          Omeganuh2_eq = ccl_Omeganuh2(1.0, 3, mnu_eq, cosmo->params.T_CMB, cosmo->data.accelerator, status);
+          Omeganuh2_eq = ccl_Omeganuh2(1.0, 3, mnu_eq, cosmo->params.T_CMB, NULL, status);
        }
   } else {
     if(fabs(cosmo->params.N_nu_rel - 3.04)>1.e-6){
@@ -1277,9 +1285,10 @@ static void ccl_cosmology_compute_power_emu(ccl_cosmology * cosmo, int * status)
   else{
     // After this loop x will contain log(k), y will contain log(P_nl), z will contain log(P_lin)
     // all in Mpc, not Mpc/h units!
-    double psout_l,ic;
     int s=0;
+#pragma omp parallel for num_threads(ccl_cosmology_num_threads(cosmo)) schedule(dynamic) reduction(|:s)
     for (int i=0; i<nk; i++) {
+      double psout_l,ic;
       for (int j = 0; j < na; j++) {
 	//The 2D interpolation routines access the function values y_{k_ia_j} with the following ordering:
 	//y_ij = y2d[j*N_k + i]
@@ -1324,47 +1333,49 @@ static void ccl_cosmology_compute_power_emu(ccl_cosmology * cosmo, int * status)
   amin = A_MIN_EMU; //limit of the emulator
   amax = ccl_splines->A_SPLINE_MAX;
   na = ccl_splines->A_SPLINE_NA_PK;
-  // The x array is initially k, but will later
-  // be overwritten with log(k)
-  double * logx= malloc(NK_EMU*sizeof(double));
-  double * y;
-  double * xstar = malloc(9 * sizeof(double));
+  double logx[NK_EMU];
+  double xstar[8];
   double * aemu = ccl_linear_spacing(amin,amax, na);
+  double * zemu = malloc(na*sizeof(double));
   double * y2d = malloc(NK_EMU * na * sizeof(double));
-  if (aemu==NULL || y2d==NULL || logx==NULL || xstar==NULL){
+  if (aemu==NULL || zemu==NULL || y2d==NULL){
+    free(aemu);
+    free(zemu);
+    free(y2d);
     *status=CCL_ERROR_MEMORY;
     ccl_cosmology_set_status_message(cosmo, "ccl_power.c: ccl_cosmology_compute_power_emu(): memory allocation error\n");
     return;
   }
 
-  //For each redshift:
-  for (int j = 0; j < na; j++){
-
-    //Turn cosmology into xstar:
-    xstar[0] = (cosmo->params.Omega_c+cosmo->params.Omega_b)*cosmo->params.h*cosmo->params.h;
-    xstar[1] = cosmo->params.Omega_b*cosmo->params.h*cosmo->params.h;
-    xstar[2] = cosmo->params.sigma8;
-    xstar[3] = cosmo->params.h;
-    xstar[4] = cosmo->params.n_s;
-    xstar[5] = cosmo->params.w0;
-    xstar[6] = cosmo->params.wa;
-    if ((cosmo->params.N_nu_mass>0) && (cosmo->config.emulator_neutrinos_method == ccl_emu_equalize)){
-		xstar[7] = Omeganuh2_eq;
-	}else{
-        xstar[7] = cosmo->params.Omega_n_mass*cosmo->params.h*cosmo->params.h;
-    }
-    xstar[8] = 1./aemu[j]-1;
-    //Need to have this here because otherwise overwritten by emu in each loop
-
-    //Call emulator at this redshift
-    ccl_pkemu(xstar,&y, status, cosmo);
-    ccl_check_status(cosmo, status);
-    if (y == NULL) return;
-    for (int i=0; i<NK_EMU; i++){
-      logx[i] = log(mode[i]);
-      y2d[j*NK_EMU+i] = log(y[i]);
-    }
+  //Turn cosmology into xstar:
+  xstar[0] = (cosmo->params.Omega_c+cosmo->params.Omega_b)*cosmo->params.h*cosmo->params.h;
+  xstar[1] = cosmo->params.Omega_b*cosmo->params.h*cosmo->params.h;
+  xstar[2] = cosmo->params.sigma8;
+  xstar[3] = cosmo->params.h;
+  xstar[4] = cosmo->params.n_s;
+  xstar[5] = cosmo->params.w0;
+  xstar[6] = cosmo->params.wa;
+  if ((cosmo->params.N_nu_mass>0) && (cosmo->config.emulator_neutrinos_method == ccl_emu_equalize)){
+    xstar[7] = Omeganuh2_eq;
+  }else{
+    xstar[7] = cosmo->params.Omega_n_mass*cosmo->params.h*cosmo->params.h;
+  }
+  for (int j = 0; j < na; j++)
+    zemu[j] = 1./aemu[j]-1;
+
+  //Call emulator once for all redshifts
+  ccl_pkemu_multiz(xstar, na, zemu, y2d, status, cosmo);
+  ccl_check_status(cosmo, status);
+  free(zemu);
+  if (*status) {
+    free(aemu);
+    free(y2d);
+    return;
   }
+  for (int i=0; i<NK_EMU; i++)
+    logx[i] = log(mode[i]);
+  for (int i=0; i<NK_EMU*na; i++)
+    y2d[i] = log(y2d[i]);
 
   gsl_spline2d * log_power_nl = gsl_spline2d_alloc(PLIN_SPLINE_TYPE, NK_EMU,na);
   int splinstatus = gsl_spline2d_init(log_power_nl, logx, aemu, y2d,NK_EMU,na);
@@ -1414,6 +1425,17 @@ void ccl_cosmology_compute_power(ccl_cosmology * cosmo, int * status)
 	  ccl_cosmology_set_status_message(cosmo, "ccl_power.c: ccl_cosmology_compute_power(): Unknown or non-implemented transfer function method: %d \n", cosmo->config.transfer_function_method);
     }
 
+    // Build the lookup tables used to evaluate the power spectra
+    if (*status==0){
+      cosmo->data.tab_p_lin=ccl_table2d_new(cosmo->data.p_lin);
+      if ((cosmo->data.tab_p_lin==NULL) ||
+	  ((cosmo->data.p_nl!=NULL) &&
+	   ((cosmo->data.tab_p_nl=ccl_table2d_new(cosmo->data.p_nl))==NULL))) {
+	*status = CCL_ERROR_SPLINE;
+	ccl_cosmology_set_status_message(cosmo, "ccl_power.c: ccl_cosmology_compute_power(): Error creating P(k,a) tables\n");
+      }
+    }
+
     ccl_check_status(cosmo,status);
     if (*status==0){
 		cosmo->computed_power = true;
@@ -1525,7 +1547,11 @@ double ccl_linear_matter_power(ccl_cosmology * cosmo, double k, double a, int *
       return exp(log_p_1);
     }
     else if(k<cosmo->data.k_max_lin){
-      gslstatus = gsl_spline2d_eval_e(cosmo->data.p_lin, log(k), a,NULL,NULL,&log_p_1);
+      // The table is not built yet while sigma8 normalizes the spline
+      if(cosmo->data.tab_p_lin!=NULL)
+        gslstatus = ccl_table2d_eval_e(cosmo->data.tab_p_lin, log(k), a, &log_p_1);
+      else
+        gslstatus = gsl_spline2d_eval_e(cosmo->data.p_lin, log(k), a,NULL,NULL,&log_p_1);
       if(gslstatus != GSL_SUCCESS) {
         ccl_raise_gsl_warning(gslstatus, "ccl_power.c: ccl_linear_matter_power():");
         *status = CCL_ERROR_SPLINE_EV;
@@ -1605,7 +1631,11 @@ double ccl_nonlin_matter_power(ccl_cosmology * cosmo, double k, double a, int *s
   }
 
   if (k < cosmo->data.k_max_nl) {
-    int gslstatus = gsl_spline2d_eval_e(cosmo->data.p_nl, log(k), a, NULL ,NULL, &log_p_1);
+    int gslstatus;
+    if (cosmo->data.tab_p_nl != NULL)
+      gslstatus = ccl_table2d_eval_e(cosmo->data.tab_p_nl, log(k), a, &log_p_1);
+    else
+      gslstatus = gsl_spline2d_eval_e(cosmo->data.p_nl, log(k), a, NULL ,NULL, &log_p_1);
     if (gslstatus != GSL_SUCCESS) {
       ccl_raise_gsl_warning(gslstatus, "ccl_power.c: ccl_nonlin_matter_power():");
       *status = CCL_ERROR_SPLINE_EV;
@@ -1635,6 +1665,135 @@ double ccl_nonlin_matter_power(ccl_cosmology * cosmo, double k, double a, int *s
   return pk;
 }
 
+/*------ ROUTINE: matter_powers_eval -----
+INPUT: ccl_cosmology * cosmo, n wavenumbers k [1/Mpc], scale factors a (a single one
+       if fixed_a is set), nonlin flag
+TASK: evaluate the linear or non-linear power spectrum for many points at once,
+      going through the P(k,a) table for all points inside it. Points requiring
+      extrapolation are passed to the scalar functions.
+*/
+static void matter_powers_eval(ccl_cosmology * cosmo, int n, double k[], double a[], int fixed_a,
+			       int nonlin, double output[], int * status)
+{
+  ccl_table2d *tab=nonlin ? cosmo->data.tab_p_nl : cosmo->data.tab_p_lin;
+  double kmin=nonlin ? cosmo->data.k_min_nl : cosmo->data.k_min_lin;
+  double kmax=nonlin ? cosmo->data.k_max_nl : cosmo->data.k_max_lin;
+  double *lk=NULL;
+
+  if (tab!=NULL)
+    lk=malloc(n*sizeof(double));
+
+  if (lk!=NULL) {
+    for (int i=0; i<n; i++)
+      lk[i]=log(k[i]);
+    if (fixed_a)
+      ccl_table2d_eval_fixed_y(tab, a[0], n, lk, output);
+    else
+      ccl_table2d_eval_array(tab, n, lk, a, output);
+    free(lk);
+  }
+  else {
+    for (int i=0; i<n; i++)
+      output[i]=NAN;
+  }
+
+  for (int i=0; i<n; i++) {
+    double ai=fixed_a ? a[0] : a[i];
+    if (isnan(output[i]) || (k[i]<=kmin) || (k[i]>=kmax) ||
+	(ai<ccl_splines->A_SPLINE_MINLOG_PK) ||
+	((cosmo->config.transfer_function_method == ccl_emulator) && (ai<A_MIN_EMU))) {
+      if (nonlin)
+	output[i]=ccl_nonlin_matter_power(cosmo, k[i], ai, status);
+      else
+	output[i]=ccl_linear_matter_power(cosmo, k[i], ai, status);
+    }
+    else {
+      output[i]=exp(output[i]);
+      if (nonlin && (cosmo->config.baryons_power_spectrum_method == ccl_bcm)) {
+	int pwstatus=0;
+	output[i]*=ccl_bcm_model_fka(cosmo, k[i], ai, &pwstatus);
+	if (pwstatus) {
+	  *status = CCL_ERROR_SPLINE_EV;
+	  ccl_cosmology_set_status_message(cosmo, "ccl_power.c: matter_powers_eval(): Error in BCM correction\n");
+	  output[i]=NAN;
+	}
+      }
+    }
+  }
+}
+
+/*------ ROUTINE: linear_matter_powers -----
+INPUT: ccl_cosmology * cosmo, n wavenumbers k [1/Mpc], scale factors a
+TASK: compute the linear power spectrum for many points
+*/
+static void linear_matter_powers(ccl_cosmology * cosmo, int n, double k[], double a[], int fixed_a,
+				 double output[], int * status)
+{
+  if (!cosmo->computed_power) ccl_cosmology_compute_power(cosmo, status);
+  if (!cosmo->computed_power) {
+    for (int i=0; i<n; i++)
+      output[i]=NAN;
+    return;
+  }
+
+  matter_powers_eval(cosmo, n, k, a, fixed_a, 0, output, status);
+}
+
+/*------ ROUTINE: nonlin_matter_powers -----
+INPUT: ccl_cosmology * cosmo, n wavenumbers k [1/Mpc], scale factors a
+TASK: compute the non-linear power spectrum for many points
+*/
+static void nonlin_matter_powers(ccl_cosmology * cosmo, int n, double k[], double a[], int fixed_a,
+				 double output[], int * status)
+{
+  switch(cosmo->config.matter_power_spectrum_method) {
+
+  case ccl_linear:
+    linear_matter_powers(cosmo, n, k, a, fixed_a, output, status);
+    return;
+
+  case ccl_halofit:
+  case ccl_emu:
+    if (!cosmo->computed_power) ccl_cosmology_compute_power(cosmo, status);
+    if (cosmo->data.p_nl == NULL) {
+      for (int i=0; i<n; i++)
+	output[i]=NAN;
+      return;
+    }
+    matter_powers_eval(cosmo, n, k, a, fixed_a, 1, output, status);
+    return;
+
+  default:
+    // Let the scalar function deal with unsupported methods
+    for (int i=0; i<n; i++)
+      output[i]=ccl_nonlin_matter_power(cosmo, k[i], fixed_a ? a[0] : a[i], status);
+  }
+}
+
+void ccl_linear_matter_powers(ccl_cosmology * cosmo, int n, double k[], double a[],
+			      double output[], int * status)
+{
+  linear_matter_powers(cosmo, n, k, a, 0, output, status);
+}
+
+void ccl_linear_matter_powers_at_a(ccl_cosmology * cosmo, double a, int nk, double k[],
+				   double output[], int * status)
+{
+  linear_matter_powers(cosmo, nk, k, &a, 1, output, status);
+}
+
+void ccl_nonlin_matter_powers(ccl_cosmology * cosmo, int n, double k[], double a[],
+			      double output[], int * status)
+{
+  nonlin_matter_powers(cosmo, n, k, a, 0, output, status);
+}
+
+void ccl_nonlin_matter_powers_at_a(ccl_cosmology * cosmo, double a, int nk, double k[],
+				   double output[], int * status)
+{
+  nonlin_matter_powers(cosmo, nk, k, &a, 1, output, status);
+}
+
 // Params for sigma(R) integrand
 typedef struct {
   ccl_cosmology *cosmo;
@@ -0,0 +1,400 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spline.h>
+#include <gsl/gsl_spline2d.h>
+
+#include "ccl.h"
+
+//Relative tolerance on the node spacing used to recognise uniform segments
+#define CCL_TABLE_SPACING_TOL 1E-6
+//Number of points located at a time by the array evaluations
+#define CCL_TABLE_BLOCK 256
+
+/* ------- ROUTINE: is_linear ------
+INPUTS: nodes x[i0..i1]
+TASK: check whether the nodes are linearly spaced
+*/
+static int is_linear(const double *x,int i0,int i1)
+{
+  if(i1<=i0)
+    return 1;
+
+  double d=(x[i1]-x[i0])/(i1-i0);
+  if(d<=0)
+    return 0;
+  for(int i=i0;i<i1;i++) {
+    if(fabs(x[i+1]-x[i]-d)>CCL_TABLE_SPACING_TOL*d)
+      return 0;
+  }
+  return 1;
+}
+
+/* ------- ROUTINE: axis_init ------
+INPUTS: number of nodes, nodes
+TASK: copy the nodes and work out whether they are log-spaced up to some node
+      and linearly spaced after it.
+*/
+static int axis_init(ccl_table_axis *ax,int n,const double *x)
+{
+  ax->n=n;
+  ax->x=malloc(n*sizeof(double));
+  if(ax->x==NULL)
+    return 1;
+  memcpy(ax->x,x,n*sizeof(double));
+
+  //Length of the leading log-spaced segment
+  int ilin=0;
+  if((n>2) && (x[0]>0) && (x[1]>x[0])) {
+    double dl=log(x[1]/x[0]);
+    ilin=1;
+    while((ilin<n-1) && (fabs(log(x[ilin+1]/x[ilin])-dl)<=CCL_TABLE_SPACING_TOL*dl))
+      ilin++;
+    //A two-node segment is also linear, so leave it to the linear part
+    if(ilin==1)
+      ilin=0;
+  }
+
+  ax->uniform=is_linear(x,ilin,n-1);
+  ax->ilin=ilin;
+  ax->lx0=log(x[0]);
+  ax->idlx=(ilin>0) ? ilin/log(x[ilin]/x[0]) : 0;
+  ax->xlin=x[ilin];
+  ax->idx=(ilin<n-1) ? (n-1-ilin)/(x[n-1]-x[ilin]) : 0;
+
+  return 0;
+}
+
+/* ------- ROUTINE: axis_find ------
+INPUTS: axis, point within its range
+TASK: return the index i of the cell such that x[i]<=x<=x[i+1]
+*/
+static int axis_find(const ccl_table_axis *ax,double x)
+{
+  int i;
+  const double *xa=ax->x;
+
+  if(ax->uniform) {
+    if(x<ax->xlin)
+      i=(int)((log(x)-ax->lx0)*ax->idlx);
+    else
+      i=ax->ilin+(int)((x-ax->xlin)*ax->idx);
+    if(i<0) i=0;
+    if(i>ax->n-2) i=ax->n-2;
+    //Correct for round-off in the arithmetic estimate
+    while((i>0) && (x<xa[i]))
+      i--;
+    while((i<ax->n-2) && (x>=xa[i+1]))
+      i++;
+  }
+  else {
+    int ilo=0,ihi=ax->n-1;
+    while(ihi-ilo>1) {
+      int imid=(ihi+ilo)/2;
+      if(xa[imid]>x)
+	ihi=imid;
+      else
+	ilo=imid;
+    }
+    i=ilo;
+  }
+
+  return i;
+}
+
+/* ------- ROUTINE: ccl_table1d_new ------
+INPUTS: GSL spline
+TASK: store the cubic of each spline interval in powers of t=(x-x_i)/(x_{i+1}-x_i),
+      obtained from the values and derivatives of the spline at the nodes
+*/
+ccl_table1d *ccl_table1d_new(gsl_spline *spl)
+{
+  int n=spl->size;
+  ccl_table1d *tab=malloc(sizeof(ccl_table1d));
+  if(tab==NULL)
+    return NULL;
+
+  tab->c=malloc(4*(n-1)*sizeof(double));
+  if(tab->c==NULL) {
+    free(tab);
+    return NULL;
+  }
+
+  if(axis_init(&(tab->ax),n,spl->x)) {
+    free(tab->c);
+    free(tab);
+    return NULL;
+  }
+
+  int gslstatus=0;
+  double d0,d1;
+  gslstatus|=gsl_spline_eval_deriv_e(spl,spl->x[0],NULL,&d0);
+  for(int i=0;i<n-1;i++) {
+    double h=spl->x[i+1]-spl->x[i];
+    double y0=spl->y[i],y1=spl->y[i+1];
+    gslstatus|=gsl_spline_eval_deriv_e(spl,spl->x[i+1],NULL,&d1);
+    tab->c[4*i+0]=y0;
+    tab->c[4*i+1]=d0*h;
+    tab->c[4*i+2]=3*(y1-y0)-(2*d0+d1)*h;
+    tab->c[4*i+3]=2*(y0-y1)+(d0+d1)*h;
+    d0=d1;
+  }
+
+  if(gslstatus) {
+    ccl_table1d_free(tab);
+    return NULL;
+  }
+
+  return tab;
+}
+
+int ccl_table1d_eval_e(const ccl_table1d *tab,double x,double *y)
+{
+  const ccl_table_axis *ax=&(tab->ax);
+  if((x<ax->x[0]) || (x>ax->x[ax->n-1]))
+    return GSL_EDOM;
+
+  int i=axis_find(ax,x);
+  const double *c=&(tab->c[4*i]);
+  double t=(x-ax->x[i])/(ax->x[i+1]-ax->x[i]);
+  *y=c[0]+t*(c[1]+t*(c[2]+t*c[3]));
+
+  return GSL_SUCCESS;
+}
+
+/* ------- ROUTINE: ccl_table1d_eval_array ------
+INPUTS: table, number of points, points
+TASK: evaluate the table in blocks of points. The cells of a block are located first,
+      and the cubics are then evaluated in a branch-free loop, which the compiler can
+      vectorize (with gathers of the coefficients on AVX2/AVX-512).
+*/
+int ccl_table1d_eval_array(const ccl_table1d *tab,int n,const double *x,double *y)
+{
+  const ccl_table_axis *ax=&(tab->ax);
+  const double xmin=ax->x[0],xmax=ax->x[ax->n-1];
+  int icell[CCL_TABLE_BLOCK];
+  double tcell[CCL_TABLE_BLOCK];
+  int gslstatus=GSL_SUCCESS;
+
+  for(int i0=0;i0<n;i0+=CCL_TABLE_BLOCK) {
+    int nblock=(n-i0<CCL_TABLE_BLOCK) ? n-i0 : CCL_TABLE_BLOCK;
+    const double *xb=&(x[i0]);
+    double *yb=&(y[i0]);
+
+    //Points outside the range (or NAN) are flagged with a negative cell index
+    for(int j=0;j<nblock;j++) {
+      if((xb[j]>=xmin) && (xb[j]<=xmax)) {
+	int ic=axis_find(ax,xb[j]);
+	icell[j]=ic;
+	tcell[j]=(xb[j]-ax->x[ic])/(ax->x[ic+1]-ax->x[ic]);
+      }
+      else {
+	icell[j]=-1;
+	tcell[j]=0;
+	gslstatus=GSL_EDOM;
+      }
+    }
+
+#pragma omp simd
+    for(int j=0;j<nblock;j++) {
+      int ic=(icell[j]<0) ? 0 : icell[j];
+      const double *c=&(tab->c[4*ic]);
+      double t=tcell[j];
+      double v=c[0]+t*(c[1]+t*(c[2]+t*c[3]));
+      yb[j]=(icell[j]<0) ? NAN : v;
+    }
+  }
+
+  return gslstatus;
+}
+
+void ccl_table1d_free(ccl_table1d *tab)
+{
+  if(tab!=NULL) {
+    free(tab->ax.x);
+    free(tab->c);
+    free(tab);
+  }
+}
+
+/* ------- ROUTINE: ccl_table2d_new ------
+INPUTS: bicubic GSL 2D spline
+TASK: store the bicubic patch of each cell as 16 coefficients c[4*p+q] of t^p u^q,
+      with t and u the fractional positions within the cell. The patches are
+      built from the values and x, y and cross derivatives at the nodes, which
+      are the same quantities GSL builds its patches from.
+*/
+ccl_table2d *ccl_table2d_new(gsl_spline2d *spl)
+{
+  int nx=spl->interp_object.xsize,ny=spl->interp_object.ysize;
+  ccl_table2d *tab=malloc(sizeof(ccl_table2d));
+  if(tab==NULL)
+    return NULL;
+  tab->ax_x.x=NULL;
+  tab->ax_y.x=NULL;
+  tab->c=malloc(16*(nx-1)*(ny-1)*sizeof(double));
+  double *zx=malloc(3*nx*ny*sizeof(double));
+  if((tab->c==NULL) || (zx==NULL) ||
+     axis_init(&(tab->ax_x),nx,spl->xarr) || axis_init(&(tab->ax_y),ny,spl->yarr)) {
+    free(zx);
+    ccl_table2d_free(tab);
+    return NULL;
+  }
+  double *zy=&(zx[nx*ny]);
+  double *zxy=&(zx[2*nx*ny]);
+
+  int gslstatus=0;
+  for(int j=0;j<ny;j++) {
+    for(int i=0;i<nx;i++) {
+      int ind=j*nx+i;
+      gslstatus|=gsl_spline2d_eval_deriv_x_e(spl,spl->xarr[i],spl->yarr[j],NULL,NULL,&(zx[ind]));
+      gslstatus|=gsl_spline2d_eval_deriv_y_e(spl,spl->xarr[i],spl->yarr[j],NULL,NULL,&(zy[ind]));
+      gslstatus|=gsl_spline2d_eval_deriv_xy_e(spl,spl->xarr[i],spl->yarr[j],NULL,NULL,&(zxy[ind]));
+    }
+  }
+  if(gslstatus) {
+    free(zx);
+    ccl_table2d_free(tab);
+    return NULL;
+  }
+
+  //Hermite basis in matrix form: coefficients = M F M^T
+  static const double M[4][4]={{1,0,0,0},{0,0,1,0},{-3,3,-2,-1},{2,-2,1,1}};
+  for(int j=0;j<ny-1;j++) {
+    double hy=spl->yarr[j+1]-spl->yarr[j];
+    for(int i=0;i<nx-1;i++) {
+      double hx=spl->xarr[i+1]-spl->xarr[i];
+      int i00=j*nx+i,i10=j*nx+i+1,i01=(j+1)*nx+i,i11=(j+1)*nx+i+1;
+      double F[4][4]={{spl->zarr[i00],spl->zarr[i01],zy[i00]*hy,zy[i01]*hy},
+		      {spl->zarr[i10],spl->zarr[i11],zy[i10]*hy,zy[i11]*hy},
+		      {zx[i00]*hx,zx[i01]*hx,zxy[i00]*hx*hy,zxy[i01]*hx*hy},
+		      {zx[i10]*hx,zx[i11]*hx,zxy[i10]*hx*hy,zxy[i11]*hx*hy}};
+      double MF[4][4];
+      for(int p=0;p<4;p++) {
+	for(int q=0;q<4;q++) {
+	  MF[p][q]=0;
+	  for(int r=0;r<4;r++)
+	    MF[p][q]+=M[p][r]*F[r][q];
+	}
+      }
+      double *c=&(tab->c[16*(j*(nx-1)+i)]);
+      for(int p=0;p<4;p++) {
+	for(int q=0;q<4;q++) {
+	  c[4*p+q]=0;
+	  for(int r=0;r<4;r++)
+	    c[4*p+q]+=MF[p][r]*M[q][r];
+	}
+      }
+    }
+  }
+  free(zx);
+
+  return tab;
+}
+
+int ccl_table2d_eval_e(const ccl_table2d *tab,double x,double y,double *z)
+{
+  const ccl_table_axis *ax=&(tab->ax_x),*ay=&(tab->ax_y);
+  if((x<ax->x[0]) || (x>ax->x[ax->n-1]) || (y<ay->x[0]) || (y>ay->x[ay->n-1]))
+    return GSL_EDOM;
+
+  int i=axis_find(ax,x);
+  int j=axis_find(ay,y);
+  const double *c=&(tab->c[16*(j*(ax->n-1)+i)]);
+  double t=(x-ax->x[i])/(ax->x[i+1]-ax->x[i]);
+  double u=(y-ay->x[j])/(ay->x[j+1]-ay->x[j]);
+  double r[4];
+  for(int p=0;p<4;p++)
+    r[p]=c[4*p]+u*(c[4*p+1]+u*(c[4*p+2]+u*c[4*p+3]));
+  *z=r[0]+t*(r[1]+t*(r[2]+t*r[3]));
+
+  return GSL_SUCCESS;
+}
+
+int ccl_table2d_eval_array(const ccl_table2d *tab,int n,const double *x,const double *y,double *z)
+{
+  int gslstatus=GSL_SUCCESS;
+
+  for(int i=0;i<n;i++) {
+    if(ccl_table2d_eval_e(tab,x[i],y[i],&(z[i]))!=GSL_SUCCESS) {
+      z[i]=NAN;
+      gslstatus=GSL_EDOM;
+    }
+  }
+
+  return gslstatus;
+}
+
+/* ------- ROUTINE: ccl_table2d_eval_fixed_y ------
+INPUTS: table, y, number of points, points x
+TASK: evaluate the table at many x for the same y. The row of cells containing y
+      is located once, and, when there are more points than cells, collapsed
+      into one cubic in t per cell before looping over x.
+*/
+int ccl_table2d_eval_fixed_y(const ccl_table2d *tab,double y,int n,const double *x,double *z)
+{
+  const ccl_table_axis *ax=&(tab->ax_x),*ay=&(tab->ax_y);
+  int nc=ax->n-1;
+
+  if((y<ay->x[0]) || (y>ay->x[ay->n-1])) {
+    for(int i=0;i<n;i++)
+      z[i]=NAN;
+    return GSL_EDOM;
+  }
+
+  int j=axis_find(ay,y);
+  double u=(y-ay->x[j])/(ay->x[j+1]-ay->x[j]);
+  const double *crow=&(tab->c[16*j*nc]);
+
+  //Collapse the row if it pays off (and memory is available)
+  double *r=NULL;
+  if(n>nc)
+    r=malloc(4*nc*sizeof(double));
+  if(r!=NULL) {
+    for(int i=0;i<nc;i++) {
+      const double *c=&(crow[16*i]);
+      for(int p=0;p<4;p++)
+	r[4*i+p]=c[4*p]+u*(c[4*p+1]+u*(c[4*p+2]+u*c[4*p+3]));
+    }
+  }
+
+  int gslstatus=GSL_SUCCESS;
+  for(int ip=0;ip<n;ip++) {
+    double xx=x[ip];
+    if((xx<ax->x[0]) || (xx>ax->x[nc])) {
+      z[ip]=NAN;
+      gslstatus=GSL_EDOM;
+      continue;
+    }
+
+    int i=axis_find(ax,xx);
+    double t=(xx-ax->x[i])/(ax->x[i+1]-ax->x[i]);
+    double rc[4];
+    const double *rr;
+    if(r!=NULL)
+      rr=&(r[4*i]);
+    else {
+      const double *c=&(crow[16*i]);
+      for(int p=0;p<4;p++)
+	rc[p]=c[4*p]+u*(c[4*p+1]+u*(c[4*p+2]+u*c[4*p+3]));
+      rr=rc;
+    }
+    z[ip]=rr[0]+t*(rr[1]+t*(rr[2]+t*rr[3]));
+  }
+  free(r);
+
+  return gslstatus;
+}
+
+void ccl_table2d_free(ccl_table2d *tab)
+{
+  if(tab!=NULL) {
+    free(tab->ax_x.x);
+    free(tab->ax_y.x);
+    free(tab->c);
+    free(tab);
+  }
+}
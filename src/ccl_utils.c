@@ -149,12 +149,38 @@ SplPar *ccl_spline_init(int n,double *x,double *y,double y0,double yf)
   if(spl==NULL)
     return NULL;
 
-  spl->intacc=gsl_interp_accel_alloc();
   spl->spline=gsl_spline_alloc(gsl_interp_cspline,n);
   int parstatus=gsl_spline_init(spl->spline,x,y,n);
   if(parstatus) {
-    gsl_interp_accel_free(spl->intacc);
     gsl_spline_free(spl->spline);
+    free(spl);
+    return NULL;
+  }
+
+  spl->x0=x[0];
+  spl->xf=x[n-1];
+  spl->y0=y0;
+  spl->yf=yf;
+
+  return spl;
+}
+
+//Spline re-initializer
+//Reuses the memory of an existing spline if it has the same number of points,
+//otherwise (or if spl is NULL) a new spline is allocated.
+//Returns NULL (after freeing spl) if the spline couldn't be initialized.
+//spl   -> spline to re-initialize (can be NULL)
+//n,x,y,y0,yf -> same as for ccl_spline_init
+SplPar *ccl_spline_reinit(SplPar *spl,int n,double *x,double *y,double y0,double yf)
+{
+  if((spl==NULL) || (spl->spline->size!=(size_t)n)) {
+    ccl_spline_free(spl);
+    return ccl_spline_init(n,x,y,y0,yf);
+  }
+
+  int parstatus=gsl_spline_init(spl->spline,x,y,n);
+  if(parstatus) {
+    ccl_spline_free(spl);
     return NULL;
   }
 
@@ -175,7 +201,7 @@ double ccl_spline_eval(double x,SplPar *spl)
     return spl->yf;
   else {
     double y;
-    int stat=gsl_spline_eval_e(spl->spline,x,spl->intacc,&y);
+    int stat=gsl_spline_eval_e(spl->spline,x,NULL,&y);
     if (stat!=GSL_SUCCESS) {
       ccl_raise_gsl_warning(stat, "ccl_utils.c: ccl_splin_eval():");
       return NAN;
@@ -312,10 +338,104 @@ double ccl_j_bessel(int l,double x)
   return jl;
 }
 
+//Spherical Bessel function table
+//lmin -> lowest order tabulated
+//nl   -> number of orders (lmin to lmin+nl-1)
+//xmax -> maximum argument
+//dx   -> spacing of the grid in x
+//At each node, ccl_j_bessel is only called for the two orders above the highest tabulated
+//one, and the lower orders down to lmin-1 are filled with the downward recurrence
+//j_{l-1}=(2l+1)*j_l/x-j_{l+1}, which is stable for j_l (unlike the upward one). The
+//derivatives, needed for the Hermite interpolation, then follow from
+//j_l'=j_{l-1}-(l+1)*j_l/x (and j_0'=-j_1).
+ccl_bessel_table *ccl_bessel_table_new(int lmin,int nl,double xmax,double dx)
+{
+  int i,il;
+  if((lmin<0) || (nl<1) || (xmax<=0) || (dx<=0))
+    return NULL;
+
+  ccl_bessel_table *tab=malloc(sizeof(ccl_bessel_table));
+  if(tab==NULL)
+    return NULL;
+  tab->lmin=lmin;
+  tab->nl=nl;
+  tab->nx=(int)(ceil(xmax/dx))+1;
+  tab->dx=dx;
+  tab->idx=1./dx;
+  tab->xmax=(tab->nx-1)*dx;
+  tab->jl=malloc(2*nl*tab->nx*sizeof(double));
+  if(tab->jl==NULL) {
+    free(tab);
+    return NULL;
+  }
+  tab->djl=&(tab->jl[nl*tab->nx]);
+
+  int ltop=lmin+nl-1;
+  for(i=0;i<tab->nx;i++) {
+    double x=i*dx;
+    if(x==0) {
+      for(il=0;il<nl;il++) {
+	int l=lmin+il;
+	tab->jl[il*tab->nx+i]=(l==0) ? 1 : 0;
+	tab->djl[il*tab->nx+i]=(l==1) ? dx/3. : 0;
+      }
+      continue;
+    }
+    double j_hi=ccl_j_bessel(ltop+1,x);
+    double j_l=ccl_j_bessel(ltop,x);
+    for(il=nl-1;il>=0;il--) {
+      int l=lmin+il;
+      double j_lo=(l>0) ? (2*l+1)*j_l/x-j_hi : 0;
+      double dj_l=(l>0) ? j_lo-(l+1)*j_l/x : -j_hi;
+      tab->jl[il*tab->nx+i]=j_l;
+      tab->djl[il*tab->nx+i]=dj_l*dx;
+      j_hi=j_l;
+      j_l=j_lo;
+    }
+  }
+
+  return tab;
+}
+
+//Evaluates a Bessel table for order l at x.
+//Arguments outside [0,xmax] are computed directly.
+double ccl_bessel_table_eval(const ccl_bessel_table *tab,int l,double x)
+{
+  double u=x*tab->idx;
+  int i=(int)u;
+  if((x<0) || (i>=tab->nx-1))
+    return ccl_j_bessel(l,x);
+
+  //Cubic Hermite interpolation
+  const double *f=&(tab->jl[(l-tab->lmin)*tab->nx+i]);
+  const double *df=&(tab->djl[(l-tab->lmin)*tab->nx+i]);
+  double t=u-i;
+  double t1=1-t;
+  return t1*t1*((1+2*t)*f[0]+t*df[0])+t*t*((3-2*t)*f[1]-t1*df[1]);
+}
+
+//Evaluates a Bessel table for order l at an array of points
+void ccl_bessel_table_eval_array(const ccl_bessel_table *tab,int l,int n,const double *x,double *jl)
+{
+  int ii;
+  for(ii=0;ii<n;ii++)
+    jl[ii]=ccl_bessel_table_eval(tab,l,x[ii]);
+}
+
+//Bessel table destructor
+void ccl_bessel_table_free(ccl_bessel_table *tab)
+{
+  if(tab==NULL)
+    return;
+  free(tab->jl);
+  free(tab);
+}
+
 //Spline destructor
 void ccl_spline_free(SplPar *spl)
 {
+  if(spl==NULL)
+    return;
   gsl_spline_free(spl->spline);
-  gsl_interp_accel_free(spl->intacc);
   free(spl);
 }
@@ -11,8 +11,10 @@
 
 /* This code is FFTLog, which is described in arXiv:astro-ph/9905191 */
 
-/* Computes the Gamma function using the Lanczos approximation */
-static double complex gamma_fftlog(double complex z)
+/* Computes the logarithm of the Gamma function using the Lanczos approximation.
+ * The logarithm is evaluated directly, since Gamma itself underflows far from
+ * the real axis, which large transforms reach. */
+static double complex lngamma_fftlog(double complex z)
 {
   /* Lanczos coefficients for g = 7 */
   static double p[] = {
@@ -28,13 +30,13 @@ static double complex gamma_fftlog(double complex z)
   };
   
   if(creal(z) < 0.5)
-    return M_PI / (sin(M_PI*z)*gamma_fftlog(1. - z));
+    return log(M_PI) - clog(csin(M_PI*z)) - lngamma_fftlog(1. - z);
   z -= 1;
   double complex x = p[0];
   for(int n = 1; n < 9; n++)
     x += p[n] / (z + (double)(n));
   double complex t = z + 7.5;
-  return sqrt(2*M_PI) * cpow(t, z+0.5) * cexp(-t) * x;
+  return 0.5*log(2*M_PI) + (z+0.5)*clog(t) - t + clog(x);
 }
 
 static double complex polar (double r, double phi)
@@ -42,12 +44,6 @@ static double complex polar (double r, double phi)
   return (r*cos(phi) +I*(r*sin(phi)));
 }
 
-static double complex lngamma_fftlog(double complex z)
-{
-  return clog(gamma_fftlog(z));
-}
-
-
 static void lngamma_4(double x, double y, double* lnr, double* arg)
 {
   double complex w = lngamma_fftlog(x+y*I);
@@ -91,7 +87,8 @@ void compute_u_coefficients(int N, double mu, double q, double L, double kcrc, d
     for(int m = 0; m <= N/2; m++) {
       lngamma_4(xp, m*y, &lnrp, &phip);
       lngamma_4(xm, m*y, &lnrm, &phim);
-      u[m] = polar(exp(q*log(2) + lnrp - lnrm), m*t + phip - phim);
+      /* The denominator is evaluated at the complex conjugate, hence phip + phim */
+      u[m] = polar(exp(q*log(2) + lnrp - lnrm), m*t + phip + phim);
     }
   }
   
@@ -132,9 +129,10 @@ void fht(int N, const double r[], const double complex a[], double k[], double c
     b[N-n-1] = tmp;
   }
   
-  /* Compute k's corresponding to input r's */
+  /* Compute k's corresponding to input r's. Reversing the output of the
+   * backward FFT shifts it by one node, so b[0] corresponds to k0r0*exp(L/N). */
   double k0r0 = kcrc * exp(-L);
-  k[0] = k0r0/r[0];
+  k[0] = k0r0 * exp(L/N) / r[0];
   for(int n = 1; n < N; n++)
     k[n] = k[0] * exp(n*L/N);
   
@@ -126,3 +126,48 @@ CTEST2(bbks,model_3) {
   int model=3;
   compare_bbks(model,data);
 }
+
+// Checks the batch power spectrum functions against the scalar ones,
+// including points that need to be extrapolated in k and a
+static void compare_bbks_batch(struct bbks_data * data)
+{
+  int status=0;
+  ccl_configuration config = default_config;
+  config.transfer_function_method = ccl_bbks;
+  ccl_parameters params = ccl_parameters_create(data->Omega_c,data->Omega_b,data->Omega_k[0],data->Neff, data->mnu,data->mnu_type, data->w_0[0],data->w_a[0],data->h,data->A_s,data->n_s,-1,-1,-1,-1,NULL,NULL, &status);
+  params.Omega_g=0;
+  params.Omega_l=data->Omega_v[0];
+  params.sigma8=data->sigma8;
+  ccl_cosmology * cosmo = ccl_cosmology_create(params, config);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nk=500;
+  double a_arr[4]={1.,0.5,0.1,0.01};
+  double k[500],a[500],pk_batch[500],pk_pairs[500];
+  for(int i=0;i<nk;i++)
+    k[i]=1E-6*pow(1E8,(i+0.5)/nk);
+
+  for(int j=0;j<4;j++) {
+    ccl_linear_matter_powers_at_a(cosmo,a_arr[j],nk,k,pk_batch,&status);
+    ASSERT_EQUAL(0,status);
+    for(int i=0;i<nk;i++) {
+      double pk=ccl_linear_matter_power(cosmo,k[i],a_arr[j],&status);
+      ASSERT_DBL_NEAR_TOL(0.,fabs(pk_batch[i]/pk-1),1E-10);
+    }
+  }
+
+  for(int i=0;i<nk;i++)
+    a[i]=0.01+0.99*i/(nk-1.);
+  ccl_nonlin_matter_powers(cosmo,nk,k,a,pk_pairs,&status);
+  ASSERT_EQUAL(0,status);
+  for(int i=0;i<nk;i++) {
+    double pk=ccl_nonlin_matter_power(cosmo,k[i],a[i],&status);
+    ASSERT_DBL_NEAR_TOL(0.,fabs(pk_pairs[i]/pk-1),1E-10);
+  }
+
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(bbks,batch) {
+  compare_bbks_batch(data);
+}
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
+#include <gsl/gsl_integration.h>
 
 #define SZ_VAL 0.4 //This will cancel the magnification contribution
 #define CLS_TOLERANCE 1E-3
@@ -39,7 +40,7 @@ static int linecount(FILE *f)
   return i0;
 }
 
-static void compare_cls(char *compare_type,struct cls_data * data)
+static void compare_cls(char *compare_type,int limber_method,struct cls_data * data)
 {
   int status=0;
 
@@ -165,6 +166,7 @@ static void compare_cls(char *compare_type,struct cls_data * data)
   double l_linstep = 20.;
   double dlk = 0.01;
   CCL_ClWorkspace *w=ccl_cl_workspace_default_limber(3001,l_logstep,l_linstep,dlk,&status);
+  w->limber_method=limber_method;
 
   ccl_angular_cls(cosmo,w,tr_nc_1,tr_nc_1,3001,ells,cls_dd_11_h,&status);
   if (status) printf("%s\n",cosmo->status_message);
@@ -246,9 +248,562 @@ static void compare_cls(char *compare_type,struct cls_data * data)
 }
 
 CTEST2(cls,analytic) {
-  compare_cls("analytic",data);
+  compare_cls("analytic",CCL_LIMBER_METHOD_QAG,data);
 }
 
 CTEST2(cls,histo) {
-  compare_cls("histo",data);
+  compare_cls("histo",CCL_LIMBER_METHOD_QAG,data);
+}
+
+CTEST2(cls,analytic_grid) {
+  compare_cls("analytic",CCL_LIMBER_METHOD_GRID,data);
+}
+
+CTEST2(cls,histo_grid) {
+  compare_cls("histo",CCL_LIMBER_METHOD_GRID,data);
+}
+
+// Creates the flat linear-theory cosmology used by the tests below
+static ccl_cosmology *linear_cosmology(struct cls_data * data,double Omega_c,double h)
+{
+  int status=0;
+  ccl_configuration config = default_config;
+  config.transfer_function_method = ccl_bbks;
+  config.matter_power_spectrum_method = ccl_linear;
+  ccl_parameters params = ccl_parameters_create_flat_lcdm(Omega_c,data->Omega_b,h,
+							  data->A_s,data->n_s, &status);
+  params.sigma8=data->sigma8;
+  return ccl_cosmology_create(params, config);
+}
+
+// Gaussian redshift distribution with constant bias, sampled at the centres of
+// NZ_GAUSS bins within 5 sigma of the mean
+#define NZ_GAUSS 512
+static void gaussian_nz(double zmean,double sigz,double bias,double *zarr,double *pzarr,double *bzarr)
+{
+  for(int ii=0;ii<NZ_GAUSS;ii++) {
+    zarr[ii]=zmean-5*sigz+10*sigz*(ii+0.5)/NZ_GAUSS;
+    pzarr[ii]=exp(-0.5*pow((zarr[ii]-zmean)/sigz,2));
+    bzarr[ii]=bias;
+  }
+}
+
+static void free_tracers(int ntracers,CCL_ClTracer **tracers)
+{
+  for(int it=0;it<ntracers;it++)
+    ccl_cl_tracer_free(tracers[it]);
+}
+
+// Checks that the C_ell matrix of a set of tracers matches the individual C_ells
+static void compare_cls_matrix(int limber_method,struct cls_data * data)
+{
+  int status=0;
+
+  ccl_cosmology *cosmo=linear_cosmology(data,data->Omega_c,data->h);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nz=NZ_GAUSS;
+  double zarr_1[NZ_GAUSS],pzarr_1[NZ_GAUSS],zarr_2[NZ_GAUSS],pzarr_2[NZ_GAUSS],bzarr[NZ_GAUSS];
+  gaussian_nz(1.0,0.15,1.,zarr_1,pzarr_1,bzarr);
+  gaussian_nz(1.5,0.15,1.,zarr_2,pzarr_2,bzarr);
+
+  //The last tracer has RSD and can't go through the Limber grid
+  CCL_ClTracer *tracers[5];
+  tracers[0]=ccl_cl_tracer_number_counts_simple(cosmo,nz,zarr_1,pzarr_1,nz,zarr_1,bzarr,&status);
+  tracers[1]=ccl_cl_tracer_number_counts_simple(cosmo,nz,zarr_2,pzarr_2,nz,zarr_2,bzarr,&status);
+  tracers[2]=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr_1,pzarr_1,&status);
+  tracers[3]=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr_2,pzarr_2,&status);
+  tracers[4]=ccl_cl_tracer_number_counts(cosmo,1,0,nz,zarr_1,pzarr_1,nz,zarr_1,bzarr,
+					 -1,NULL,NULL,&status);
+  ASSERT_EQUAL(0,status);
+
+  int npairs=0,pair1[15],pair2[15];
+  for(int i1=0;i1<5;i1++) {
+    for(int i2=i1;i2<5;i2++) {
+      pair1[npairs]=i1;
+      pair2[npairs]=i2;
+      npairs++;
+    }
+  }
+
+  int nl=100;
+  int ells[100];
+  for(int ii=0;ii<nl;ii++)
+    ells[ii]=2+30*ii;
+  CCL_ClWorkspace *w=ccl_cl_workspace_default_limber(3001,1.05,20,0.01,&status);
+  ASSERT_EQUAL(0,status);
+  w->limber_method=limber_method;
+
+  double *cl_matrix=malloc(npairs*nl*sizeof(double));
+  double cl_pair[100];
+  ccl_angular_cls_matrix(cosmo,w,5,tracers,npairs,pair1,pair2,nl,ells,cl_matrix,&status);
+  ASSERT_EQUAL(0,status);
+
+  for(int ip=0;ip<npairs;ip++) {
+    ccl_angular_cls(cosmo,w,tracers[pair1[ip]],tracers[pair2[ip]],nl,ells,cl_pair,&status);
+    ASSERT_EQUAL(0,status);
+    for(int ii=0;ii<nl;ii++)
+      ASSERT_DBL_NEAR_TOL(cl_pair[ii],cl_matrix[ip*nl+ii],1E-10*fabs(cl_pair[ii]));
+  }
+
+  //Out-of-range tracer indices are an error
+  pair2[0]=5;
+  ccl_angular_cls_matrix(cosmo,w,5,tracers,1,pair1,pair2,nl,ells,cl_matrix,&status);
+  ASSERT_EQUAL(CCL_ERROR_INCONSISTENT,status);
+
+  free(cl_matrix);
+  ccl_cl_workspace_free(w);
+  free_tracers(5,tracers);
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(cls,matrix_qag) {
+  compare_cls_matrix(CCL_LIMBER_METHOD_QAG,data);
+}
+
+CTEST2(cls,matrix_grid) {
+  compare_cls_matrix(CCL_LIMBER_METHOD_GRID,data);
+}
+
+// Checks that the C_ells computed at adaptively chosen nodes match those computed
+// at every multipole
+static void compare_cls_adaptive(struct cls_data * data)
+{
+  int status=0;
+
+  ccl_cosmology *cosmo=linear_cosmology(data,data->Omega_c,data->h);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nz=NZ_GAUSS;
+  double zarr[NZ_GAUSS],pzarr[NZ_GAUSS],bzarr[NZ_GAUSS];
+  gaussian_nz(1.0,0.15,1.,zarr,pzarr,bzarr);
+  CCL_ClTracer *tracers[2];
+  tracers[0]=ccl_cl_tracer_number_counts_simple(cosmo,nz,zarr,pzarr,nz,zarr,bzarr,&status);
+  tracers[1]=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr,pzarr,&status);
+  ASSERT_EQUAL(0,status);
+
+  int nl=1999;
+  int *ells=malloc(nl*sizeof(int));
+  double *cl_all=malloc(nl*sizeof(double));
+  double *cl_adapt=malloc(nl*sizeof(double));
+  for(int ii=0;ii<nl;ii++)
+    ells[ii]=ii+2;
+
+  // Every multipole is a node
+  CCL_ClWorkspace *w=ccl_cl_workspace_default_limber(ells[nl-1]+1,1.05,1,0.01,&status);
+  ASSERT_EQUAL(0,status);
+
+  int pair1[3]={0,0,1},pair2[3]={0,1,1};
+  for(int ip=0;ip<3;ip++) {
+    CCL_ClTracer *clt1=tracers[pair1[ip]],*clt2=tracers[pair2[ip]];
+    w->l_epsrel=0;
+    ccl_angular_cls(cosmo,w,clt1,clt2,nl,ells,cl_all,&status);
+    w->l_epsrel=1E-4;
+    ccl_angular_cls(cosmo,w,clt1,clt2,nl,ells,cl_adapt,&status);
+    ASSERT_EQUAL(0,status);
+    for(int ii=0;ii<nl;ii++)
+      ASSERT_DBL_NEAR_TOL(1.,cl_adapt[ii]/cl_all[ii],1E-3);
+  }
+
+  free(ells);
+  free(cl_all);
+  free(cl_adapt);
+  ccl_cl_workspace_free(w);
+  free_tracers(2,tracers);
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(cls,adaptive_nodes) {
+  compare_cls_adaptive(data);
+}
+
+// Compares bandpowers with sparse windows against the power spectra binned by hand
+static void compare_cls_bandpowers(struct cls_data * data)
+{
+  int status=0;
+
+  ccl_cosmology *cosmo=linear_cosmology(data,data->Omega_c,data->h);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nz=NZ_GAUSS;
+  double zarr[NZ_GAUSS],pzarr[NZ_GAUSS],bzarr[NZ_GAUSS];
+  gaussian_nz(1.0,0.15,1.,zarr,pzarr,bzarr);
+  CCL_ClTracer *tracers[2];
+  tracers[0]=ccl_cl_tracer_number_counts_simple(cosmo,nz,zarr,pzarr,nz,zarr,bzarr,&status);
+  tracers[1]=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr,pzarr,&status);
+  ASSERT_EQUAL(0,status);
+
+  // Overlapping triangular windows of width 2*dl centred every dl multipoles
+  int nb=20,dl=50,lmax=(nb+1)*dl;
+  int *band_ptr=malloc((nb+1)*sizeof(int));
+  int *band_l=malloc(nb*2*dl*sizeof(int));
+  double *band_w=malloc(nb*2*dl*sizeof(double));
+  band_ptr[0]=0;
+  for(int ib=0;ib<nb;ib++) {
+    int nnz=band_ptr[ib];
+    for(int l=ib*dl+1;l<(ib+2)*dl;l++) {
+      band_l[nnz]=l;
+      band_w[nnz]=(1.-fabs(l-(ib+1)*dl)/dl)/dl;
+      nnz++;
+    }
+    band_ptr[ib+1]=nnz;
+  }
+
+  int nl=lmax+1;
+  int *ells=malloc(nl*sizeof(int));
+  for(int ii=0;ii<nl;ii++)
+    ells[ii]=ii;
+  CCL_ClWorkspace *w=ccl_cl_workspace_default_limber(lmax+1,1.05,20,0.01,&status);
+  ASSERT_EQUAL(0,status);
+
+  int pair1[3]={0,0,1},pair2[3]={0,1,1};
+  double *cl=malloc(3*nl*sizeof(double));
+  double *cb=malloc(3*nb*sizeof(double));
+  ccl_angular_cls_matrix(cosmo,w,2,tracers,3,pair1,pair2,nl,ells,cl,&status);
+  ccl_angular_cls_bandpowers(cosmo,w,2,tracers,3,pair1,pair2,nb,band_ptr,band_l,band_w,cb,&status);
+  ASSERT_EQUAL(0,status);
+  for(int ip=0;ip<3;ip++) {
+    for(int ib=0;ib<nb;ib++) {
+      double cb_expected=0;
+      for(int j=band_ptr[ib];j<band_ptr[ib+1];j++)
+	cb_expected+=band_w[j]*cl[ip*nl+band_l[j]];
+      ASSERT_DBL_NEAR_TOL(1.,cb[ip*nb+ib]/cb_expected,1E-10);
+    }
+  }
+
+  // Windows that are not in CSR format
+  band_ptr[1]=band_ptr[2]+1;
+  ccl_angular_cls_bandpowers(cosmo,w,2,tracers,3,pair1,pair2,nb,band_ptr,band_l,band_w,cb,&status);
+  ASSERT_EQUAL(CCL_ERROR_INCONSISTENT,status);
+
+  free(band_ptr);
+  free(band_l);
+  free(band_w);
+  free(ells);
+  free(cl);
+  free(cb);
+  ccl_cl_workspace_free(w);
+  free_tracers(2,tracers);
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(cls,bandpowers) {
+  compare_cls_bandpowers(data);
+}
+
+// Checks the lensing and magnification windows of a narrow redshift distribution
+// against the geometric factor of a single source plane, 1-chi/chi_s
+static void check_lensing_window(struct cls_data * data)
+{
+  int status=0;
+
+  ccl_cosmology *cosmo=linear_cosmology(data,data->Omega_c,data->h);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nz=NZ_GAUSS;
+  double zs=1.;
+  double zarr[NZ_GAUSS],pzarr[NZ_GAUSS],bzarr[NZ_GAUSS],szarr[NZ_GAUSS]={0};
+  gaussian_nz(zs,0.01,1.,zarr,pzarr,bzarr);
+  CCL_ClTracer *tracers[2];
+  CCL_ClTracer *tr_wl=tracers[0]=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr,pzarr,&status);
+  CCL_ClTracer *tr_nc=tracers[1]=ccl_cl_tracer_number_counts(cosmo,0,1,nz,zarr,pzarr,nz,zarr,bzarr,
+							     nz,zarr,szarr,&status);
+  ASSERT_EQUAL(0,status);
+
+  double chi_s=ccl_comoving_radial_distance(cosmo,1./(1+zs),&status);
+  for(int ii=0;ii<10;ii++) {
+    double a=1./(1+0.1*ii*zs);
+    double chi=ccl_comoving_radial_distance(cosmo,a,&status);
+    double w_expected=1-chi/chi_s;
+    double w_wl=ccl_get_tracer_fa(cosmo,tr_wl,a,CCL_CLT_WL,&status);
+    double w_wm=ccl_get_tracer_fa(cosmo,tr_nc,a,CCL_CLT_WM,&status);
+    ASSERT_DBL_NEAR_TOL(w_expected,w_wl,1E-3);
+    ASSERT_DBL_NEAR_TOL(w_expected,w_wm,1E-3);
+  }
+  ASSERT_EQUAL(0,status);
+
+  free_tracers(2,tracers);
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(cls,lensing_window) {
+  check_lensing_window(data);
+}
+
+// Integrand of the lensing window of a Gaussian N(z) in redshift,
+//   W(chi) = \int_{z(chi)} dz N(z) (1-chi/chi(z)),
+// used as a QAG reference for the windows computed by CCL
+typedef struct {
+  ccl_cosmology *cosmo;
+  double chi,zmean,sigz;
+} WindowPar;
+
+static double window_integrand(double z,void *params)
+{
+  int status=0;
+  WindowPar *p=(WindowPar *)params;
+  double nz=exp(-0.5*pow((z-p->zmean)/p->sigz,2))/(sqrt(2*M_PI)*p->sigz);
+  return nz*(1-p->chi/ccl_comoving_radial_distance(p->cosmo,1./(1+z),&status));
+}
+
+// Checks the lensing window of an N(z) much narrower than the spacing of the
+// window nodes against a direct QAG integration
+static void check_lensing_window_narrow(struct cls_data * data)
+{
+  int status=0;
+
+  ccl_cosmology *cosmo=linear_cosmology(data,data->Omega_c,data->h);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nz=NZ_GAUSS;
+  double zs=1.,sigz=5E-4;
+  double zarr[NZ_GAUSS],pzarr[NZ_GAUSS],bzarr[NZ_GAUSS];
+  gaussian_nz(zs,sigz,1.,zarr,pzarr,bzarr);
+  CCL_ClTracer *tr_wl=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr,pzarr,&status);
+  ASSERT_EQUAL(0,status);
+
+  WindowPar par;
+  gsl_function F;
+  gsl_integration_workspace *w=gsl_integration_workspace_alloc(1000);
+  par.cosmo=cosmo; par.zmean=zs; par.sigz=sigz;
+  F.function=&window_integrand;
+  F.params=&par;
+  for(int ii=0;ii<5;ii++) {
+    double a=1./(1+0.2*ii*zs);
+    double w_qag,err;
+    par.chi=ccl_comoving_radial_distance(cosmo,a,&status);
+    ASSERT_EQUAL(0,gsl_integration_qag(&F,zs-10*sigz,zs+10*sigz,0,1E-8,1000,
+				       GSL_INTEG_GAUSS41,w,&w_qag,&err));
+    double w_wl=ccl_get_tracer_fa(cosmo,tr_wl,a,CCL_CLT_WL,&status);
+    ASSERT_DBL_NEAR_TOL(w_qag,w_wl,1E-4*w_qag);
+  }
+  ASSERT_EQUAL(0,status);
+  gsl_integration_workspace_free(w);
+
+  ccl_cl_tracer_free(tr_wl);
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(cls,lensing_window_narrow) {
+  check_lensing_window_narrow(data);
+}
+
+// Checks that a tracer built for one cosmology and rebound to another one
+// is the same as a tracer built directly for the second cosmology
+static void check_rebind(struct cls_data * data)
+{
+  int status=0;
+  ccl_cosmology *cosmo_a=linear_cosmology(data,0.25,0.67);
+  ccl_cosmology *cosmo_b=linear_cosmology(data,data->Omega_c,data->h);
+  ASSERT_NOT_NULL(cosmo_a);
+  ASSERT_NOT_NULL(cosmo_b);
+
+  int nz=NZ_GAUSS;
+  double zarr[NZ_GAUSS],pzarr[NZ_GAUSS],bzarr[NZ_GAUSS],szarr[NZ_GAUSS];
+  gaussian_nz(0.7,0.1,1.,zarr,pzarr,bzarr);
+  //Redshift-dependent bias, so that its spline is rebound too
+  for(int ii=0;ii<nz;ii++) {
+    bzarr[ii]=1+zarr[ii];
+    szarr[ii]=0.2;
+  }
+
+  CCL_ClTracer *tr_new[3],*tr_rebound[3];
+  tr_new[0]=ccl_cl_tracer_number_counts(cosmo_b,0,1,nz,zarr,pzarr,nz,zarr,bzarr,
+					nz,zarr,szarr,&status);
+  tr_new[1]=ccl_cl_tracer_lensing_simple(cosmo_b,nz,zarr,pzarr,&status);
+  tr_new[2]=ccl_cl_tracer_cmblens(cosmo_b,1100.,&status);
+  tr_rebound[0]=ccl_cl_tracer_number_counts(cosmo_a,0,1,nz,zarr,pzarr,nz,zarr,bzarr,
+					    nz,zarr,szarr,&status);
+  tr_rebound[1]=ccl_cl_tracer_lensing_simple(cosmo_a,nz,zarr,pzarr,&status);
+  tr_rebound[2]=ccl_cl_tracer_cmblens(cosmo_a,1100.,&status);
+  ASSERT_EQUAL(0,status);
+
+  CCL_ClWorkspace *w=ccl_cl_workspace_default_limber(1001,1.05,50,0.01,&status);
+  ASSERT_EQUAL(0,status);
+
+  //Compute transfer functions for the first cosmology, which rebinding must discard
+  int ells[5]={2,10,100,300,1000};
+  double cl_new[5],cl_rebound[5];
+  ccl_angular_cls(cosmo_a,w,tr_rebound[0],tr_rebound[1],5,ells,cl_rebound,&status);
+  ASSERT_EQUAL(0,status);
+
+  for(int it=0;it<3;it++)
+    ccl_cl_tracer_rebind(cosmo_b,tr_rebound[it],&status);
+  ASSERT_EQUAL(0,status);
+
+  for(int it=0;it<3;it++) {
+    ASSERT_DBL_NEAR_TOL(tr_new[it]->chimin,tr_rebound[it]->chimin,0.);
+    ASSERT_DBL_NEAR_TOL(tr_new[it]->chimax,tr_rebound[it]->chimax,0.);
+    ASSERT_DBL_NEAR_TOL(tr_new[it]->prefac_lensing,tr_rebound[it]->prefac_lensing,0.);
+  }
+  for(int ii=0;ii<10;ii++) {
+    double a=1./(1+0.15*ii);
+    ASSERT_DBL_NEAR_TOL(ccl_get_tracer_fa(cosmo_b,tr_new[0],a,CCL_CLT_WM,&status),
+			ccl_get_tracer_fa(cosmo_b,tr_rebound[0],a,CCL_CLT_WM,&status),0.);
+    ASSERT_DBL_NEAR_TOL(ccl_get_tracer_fa(cosmo_b,tr_new[1],a,CCL_CLT_WL,&status),
+			ccl_get_tracer_fa(cosmo_b,tr_rebound[1],a,CCL_CLT_WL,&status),0.);
+  }
+  ASSERT_EQUAL(0,status);
+
+  for(int i1=0;i1<3;i1++) {
+    for(int i2=i1;i2<3;i2++) {
+      ccl_angular_cls(cosmo_b,w,tr_new[i1],tr_new[i2],5,ells,cl_new,&status);
+      ccl_angular_cls(cosmo_b,w,tr_rebound[i1],tr_rebound[i2],5,ells,cl_rebound,&status);
+      ASSERT_EQUAL(0,status);
+      for(int ii=0;ii<5;ii++)
+	ASSERT_DBL_NEAR_TOL(cl_new[ii],cl_rebound[ii],0.);
+    }
+  }
+
+  ccl_cl_workspace_free(w);
+  free_tracers(3,tr_new);
+  free_tracers(3,tr_rebound);
+  ccl_cosmology_free(cosmo_a);
+  ccl_cosmology_free(cosmo_b);
+}
+
+CTEST2(cls,rebind) {
+  check_rebind(data);
+}
+
+// Checks that a tracer with a photo-z shift and stretch matches a tracer
+// built directly from the shifted and stretched redshift distribution
+static void check_photoz(struct cls_data * data)
+{
+  int status=0;
+  double dz=0.1,stretch=0.9;
+  ccl_cosmology *cosmo=linear_cosmology(data,data->Omega_c,data->h);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nz=NZ_GAUSS;
+  double zarr[NZ_GAUSS],pzarr[NZ_GAUSS],bzarr[NZ_GAUSS],zarr_pz[NZ_GAUSS];
+  gaussian_nz(0.7,0.1,1.,zarr,pzarr,bzarr);
+
+  CCL_ClTracer *tracers[4];
+  CCL_ClTracer *tr_nc=tracers[0]=ccl_cl_tracer_number_counts_simple(cosmo,nz,zarr,pzarr,nz,zarr,bzarr,&status);
+  CCL_ClTracer *tr_wl=tracers[1]=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr,pzarr,&status);
+  ASSERT_EQUAL(0,status);
+  ASSERT_DBL_NEAR_TOL(0.7,tr_wl->nz_mean,1E-4);
+
+  //Tracers built from the transformed N(z)
+  for(int ii=0;ii<nz;ii++)
+    zarr_pz[ii]=tr_wl->nz_mean+dz+stretch*(zarr[ii]-tr_wl->nz_mean);
+  CCL_ClTracer *tr_nc_pz=tracers[2]=ccl_cl_tracer_number_counts_simple(cosmo,nz,zarr_pz,pzarr,nz,zarr,bzarr,&status);
+  CCL_ClTracer *tr_wl_pz=tracers[3]=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr_pz,pzarr,&status);
+  ASSERT_EQUAL(0,status);
+
+  ccl_cl_tracer_set_photoz(cosmo,tr_nc,dz,stretch,&status);
+  ccl_cl_tracer_set_photoz(cosmo,tr_wl,dz,stretch,&status);
+  ASSERT_EQUAL(0,status);
+
+  ASSERT_DBL_NEAR_TOL(1.,tr_nc->chimin/tr_nc_pz->chimin,1E-6);
+  ASSERT_DBL_NEAR_TOL(1.,tr_nc->chimax/tr_nc_pz->chimax,1E-6);
+  for(int ii=0;ii<10;ii++) {
+    double a=1./(1+0.1*ii);
+    double nz_pz=ccl_get_tracer_fa(cosmo,tr_nc_pz,a,CCL_CLT_NZ,&status);
+    double wl_pz=ccl_get_tracer_fa(cosmo,tr_wl_pz,a,CCL_CLT_WL,&status);
+    ASSERT_DBL_NEAR_TOL(nz_pz,ccl_get_tracer_fa(cosmo,tr_nc,a,CCL_CLT_NZ,&status),1E-8);
+    ASSERT_DBL_NEAR_TOL(wl_pz,ccl_get_tracer_fa(cosmo,tr_wl,a,CCL_CLT_WL,&status),1E-6*wl_pz);
+  }
+  ASSERT_EQUAL(0,status);
+
+  CCL_ClWorkspace *w=ccl_cl_workspace_default_limber(1001,1.05,50,0.01,&status);
+  ASSERT_EQUAL(0,status);
+  int ells[5]={2,10,100,300,1000};
+  double cl[5],cl_pz[5];
+  ccl_angular_cls(cosmo,w,tr_nc,tr_wl,5,ells,cl,&status);
+  ccl_angular_cls(cosmo,w,tr_nc_pz,tr_wl_pz,5,ells,cl_pz,&status);
+  ASSERT_EQUAL(0,status);
+  for(int ii=0;ii<5;ii++)
+    ASSERT_DBL_NEAR_TOL(1.,cl[ii]/cl_pz[ii],1E-5);
+
+  ccl_cl_workspace_free(w);
+  free_tracers(4,tracers);
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(cls,photoz) {
+  check_photoz(data);
+}
+
+// Checks that the power spectra recombined from bias templates match those of
+// tracers with the corresponding (constant) bias
+static void check_bias_templates(struct cls_data * data)
+{
+  int status=0;
+  double bias=1.7;
+  ccl_cosmology *cosmo=linear_cosmology(data,data->Omega_c,data->h);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nz=NZ_GAUSS;
+  double zarr[NZ_GAUSS],pzarr[NZ_GAUSS],bzarr[NZ_GAUSS],szarr[NZ_GAUSS];
+  gaussian_nz(0.7,0.1,bias,zarr,pzarr,bzarr);
+  for(int ii=0;ii<nz;ii++)
+    szarr[ii]=0.2;
+  CCL_ClTracer *tracers[3];
+  CCL_ClTracer *tr_mag=tracers[0]=ccl_cl_tracer_number_counts(cosmo,0,1,nz,zarr,pzarr,nz,zarr,bzarr,
+							      nz,zarr,szarr,&status);
+  CCL_ClTracer *tr_rsd=tracers[1]=ccl_cl_tracer_number_counts(cosmo,1,0,nz,zarr,pzarr,nz,zarr,bzarr,
+							      -1,NULL,NULL,&status);
+  CCL_ClTracer *tr_wl=tracers[2]=ccl_cl_tracer_lensing_simple(cosmo,nz,zarr,pzarr,&status);
+  ASSERT_EQUAL(0,status);
+  ASSERT_EQUAL(3,ccl_cl_tracer_n_bias_templates(tr_mag,2));
+  ASSERT_EQUAL(3,ccl_cl_tracer_n_bias_templates(tr_rsd,2));
+  ASSERT_EQUAL(1,ccl_cl_tracer_n_bias_templates(tr_wl,2));
+
+  CCL_ClWorkspace *w=ccl_cl_workspace_default_limber(1001,1.05,50,0.01,&status);
+  ASSERT_EQUAL(0,status);
+  int nl=5;
+  int ells[5]={2,10,100,300,1000};
+  double z_edges[3]={0.,0.7,10.};
+  double coeffs[3]={bias,bias,1.};
+  double cl[5],cl_templates[45];
+
+  //Magnification and lensing, on the Limber grid
+  w->limber_method=CCL_LIMBER_METHOD_GRID;
+  ccl_angular_cls_bias_templates(cosmo,w,tr_mag,tr_wl,2,z_edges,nl,ells,cl_templates,&status);
+  ccl_angular_cls(cosmo,w,tr_mag,tr_wl,nl,ells,cl,&status);
+  ASSERT_EQUAL(0,status);
+  for(int ii=0;ii<nl;ii++) {
+    double cl_sum=0;
+    for(int i1=0;i1<3;i1++)
+      cl_sum+=coeffs[i1]*cl_templates[i1*nl+ii];
+    ASSERT_DBL_NEAR_TOL(1.,cl_sum/cl[ii],1E-8);
+  }
+
+  ccl_angular_cls_bias_templates(cosmo,w,tr_mag,tr_mag,2,z_edges,nl,ells,cl_templates,&status);
+  ccl_angular_cls(cosmo,w,tr_mag,tr_mag,nl,ells,cl,&status);
+  ASSERT_EQUAL(0,status);
+  for(int ii=0;ii<nl;ii++) {
+    double cl_sum=0;
+    for(int i1=0;i1<3;i1++) {
+      for(int i2=0;i2<3;i2++) {
+	ASSERT_DBL_NEAR_TOL(cl_templates[(i1*3+i2)*nl+ii],cl_templates[(i2*3+i1)*nl+ii],0.);
+	cl_sum+=coeffs[i1]*coeffs[i2]*cl_templates[(i1*3+i2)*nl+ii];
+      }
+    }
+    ASSERT_DBL_NEAR_TOL(1.,cl_sum/cl[ii],1E-8);
+  }
+
+  //RSD, integrated with QAG
+  w->limber_method=CCL_LIMBER_METHOD_QAG;
+  ccl_angular_cls_bias_templates(cosmo,w,tr_rsd,tr_rsd,2,z_edges,nl,ells,cl_templates,&status);
+  ccl_angular_cls(cosmo,w,tr_rsd,tr_rsd,nl,ells,cl,&status);
+  ASSERT_EQUAL(0,status);
+  for(int ii=0;ii<nl;ii++) {
+    double cl_sum=0;
+    for(int i1=0;i1<3;i1++) {
+      for(int i2=0;i2<3;i2++)
+	cl_sum+=coeffs[i1]*coeffs[i2]*cl_templates[(i1*3+i2)*nl+ii];
+    }
+    ASSERT_DBL_NEAR_TOL(1.,cl_sum/cl[ii],CLS_TOLERANCE);
+  }
+
+  ccl_cl_workspace_free(w);
+  free_tracers(3,tracers);
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(cls,bias_templates) {
+  check_bias_templates(data);
 }
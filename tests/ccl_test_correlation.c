@@ -1,4 +1,5 @@
 #include "ccl.h"
+#include "fftlog.h"
 #include "ctest.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -389,3 +390,46 @@ CTEST2(corrs,analytic_fftlog) {
 CTEST2(corrs,analytic_bessel) {
   compare_corr("analytic",CCL_CORR_BESSEL,data);
 }
+
+// Checks the FFTLog Hankel transforms against analytic pairs. For a Gaussian C_ell,
+// xi_0(theta) is also Gaussian, and sensitive to the theta grid of the output.
+// With a bias q, fht() transforms a(r) (kr)^q J_mu(kr), and r^mu exp(-r^2/2) is its
+// own Hankel transform.
+CTEST2(corrs,fftlog_hankel) {
+  int N=1024;
+  double sig=0.01;
+  double *l=malloc(N*sizeof(double)),*cl=malloc(N*sizeof(double));
+  double *th=malloc(N*sizeof(double)),*xi=malloc(N*sizeof(double));
+  for(int ii=0;ii<N;ii++) {
+    l[ii]=pow(10.,-2+8.*ii/(N-1.));
+    cl[ii]=exp(-0.5*l[ii]*l[ii]*sig*sig);
+  }
+  fftlog_ComputeXi2D(0,N,l,cl,th,xi);
+  for(int ii=0;ii<N;ii++) {
+    if((th[ii]>1E-4) && (th[ii]<3*sig)) {
+      double xi_expected=exp(-0.5*th[ii]*th[ii]/(sig*sig))/(2*M_PI*sig*sig);
+      ASSERT_DBL_NEAR_TOL(1.,xi[ii]/xi_expected,2E-3);
+    }
+  }
+
+  double complex *a=malloc(N*sizeof(double complex)),*b=malloc(N*sizeof(double complex));
+  double *r=malloc(N*sizeof(double)),*k=malloc(N*sizeof(double));
+  double qs[3]={0.,0.5,-0.5};
+  for(int iq=0;iq<3;iq++) {
+    double q=qs[iq];
+    for(int ii=0;ii<N;ii++) {
+      r[ii]=pow(10.,-4+8.*ii/(N-1.));
+      a[ii]=pow(r[ii],3-q)*exp(-0.5*r[ii]*r[ii]);
+    }
+    fht(N,r,a,k,b,2.,q,1.,0,NULL);
+    for(int ii=0;ii<N;ii++) {
+      if((k[ii]>0.05) && (k[ii]<5)) {
+	double b_expected=pow(k[ii],3+q)*exp(-0.5*k[ii]*k[ii]);
+	ASSERT_DBL_NEAR_TOL(1.,creal(b[ii])/b_expected,1E-6);
+      }
+    }
+  }
+
+  free(l); free(cl); free(th); free(xi);
+  free(a); free(b); free(r); free(k);
+}
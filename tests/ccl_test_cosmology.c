@@ -1,5 +1,6 @@
 #include "ccl.h"
 #include "ctest.h"
+#include <math.h>
 
 // We can define any constants we want to use in a set of tests here.
 // They are accessible as data->Omega_c, etc., in the tests themselves below.
@@ -52,3 +53,42 @@ CTEST2(cosmology, create_general_cosmo) {
   ASSERT_EQUAL(cosmo->status, 0);
   ASSERT_DBL_NEAR_TOL(cosmo->data.growth0, 1., 1e-10);
 }
+
+// Check that an invalid scale factor in the array background functions
+// only invalidates its own output
+CTEST2(cosmology, background_arrays_invalid) {
+  ccl_configuration config = default_config;
+  ccl_parameters params = ccl_parameters_create_flat_lcdm(
+    data->Omega_c, data->Omega_b, data->h, data->A_s, data->n_s,
+    &(data->status));
+  ccl_cosmology * cosmo = ccl_cosmology_create(params, config);
+
+  double a[4]={0.3,1.5,0.6,0.9};
+  double chi[4],growth[4],hz[4];
+  int status=0;
+  ccl_set_error_policy(CCL_ERROR_POLICY_CONTINUE);
+  ccl_comoving_radial_distances(cosmo, 4, a, chi, &status);
+  ASSERT_EQUAL(CCL_ERROR_COMPUTECHI, status);
+  status=0;
+  ccl_growth_factors(cosmo, 4, a, growth, &status);
+  ASSERT_EQUAL(CCL_ERROR_COMPUTECHI, status);
+  status=0;
+  ccl_h_over_h0s(cosmo, 4, a, hz, &status);
+  ASSERT_EQUAL(CCL_ERROR_COMPUTECHI, status);
+  ccl_set_error_policy(CCL_ERROR_POLICY_EXIT);
+
+  status=0;
+  ASSERT_TRUE(isnan(chi[1]));
+  ASSERT_TRUE(isnan(growth[1]));
+  ASSERT_TRUE(isnan(hz[1]));
+  int valid[3]={0,2,3};
+  for(int j=0; j<3; j++) {
+    int i=valid[j];
+    ASSERT_DBL_NEAR_TOL(ccl_comoving_radial_distance(cosmo, a[i], &status), chi[i], 1E-10*chi[i]);
+    ASSERT_DBL_NEAR_TOL(ccl_growth_factor(cosmo, a[i], &status), growth[i], 1E-10*growth[i]);
+    ASSERT_DBL_NEAR_TOL(ccl_h_over_h0(cosmo, a[i], &status), hz[i], 1E-10*hz[i]);
+  }
+  ASSERT_EQUAL(0, status);
+
+  ccl_cosmology_free(cosmo);
+}
@@ -1,4 +1,5 @@
 #include "ccl.h"
+#include "ccl_emu17.h"
 #include "ctest.h"
 #include <stdio.h>
 #include <math.h>
@@ -187,3 +188,69 @@ CTEST2(emu,model_6) {
   int model=6;
   compare_emu(model,data);
 }
+
+//Fills the emulator inputs for the i-th test cosmology
+static void emu_xstar(struct emu_data *data,int i,double *xstar)
+{
+  double h2=data->h[i]*data->h[i];
+  xstar[0]=(data->Omega_c[i]+data->Omega_b[i])*h2;
+  xstar[1]=data->Omega_b[i]*h2;
+  xstar[2]=data->sigma8[i];
+  xstar[3]=data->h[i];
+  xstar[4]=data->n_s[i];
+  xstar[5]=data->w_0[i];
+  xstar[6]=data->w_a[i];
+  xstar[7]=0.;
+}
+
+#define EMU_NZ 3
+
+//Check that the batched emulator gives the same spectra as one call per
+//cosmology, and that an out-of-bounds cosmology only invalidates its own spectra
+CTEST2(emu,batch) {
+  int status=0;
+  double zstar[EMU_NZ]={0.,0.4,1.5};
+  double xstar[6*8],pk_one[EMU_NZ*NK_EMU];
+  double *pk_batch=malloc(6*EMU_NZ*NK_EMU*sizeof(double));
+  ASSERT_NOT_NULL(pk_batch);
+
+  ccl_configuration config = default_config;
+  ccl_parameters params = ccl_parameters_create_flat_lcdm(data->Omega_c[0],data->Omega_b[0],data->h[0],
+							   2.1e-9,data->n_s[0],&status);
+  ccl_cosmology * cosmo = ccl_cosmology_create(params, config);
+  ASSERT_NOT_NULL(cosmo);
+
+  for(int c=0;c<6;c++)
+    emu_xstar(data,c,&(xstar[c*8]));
+
+  ccl_pkemu_batch(6,xstar,EMU_NZ,zstar,pk_batch,&status,cosmo);
+  ASSERT_EQUAL(0,status);
+  for(int c=0;c<6;c++) {
+    ccl_pkemu_multiz(&(xstar[c*8]),EMU_NZ,zstar,pk_one,&status,cosmo);
+    ASSERT_EQUAL(0,status);
+    for(int i=0;i<EMU_NZ*NK_EMU;i++)
+      ASSERT_DBL_NEAR_TOL(pk_one[i],pk_batch[c*EMU_NZ*NK_EMU+i],1E-10*pk_one[i]);
+  }
+
+  //Push sigma8 of the third cosmology outside the emulator range
+  xstar[2*8+2]=10.;
+  ccl_set_error_policy(CCL_ERROR_POLICY_CONTINUE);
+  ccl_pkemu_batch(6,xstar,EMU_NZ,zstar,pk_batch,&status,cosmo);
+  ccl_set_error_policy(CCL_ERROR_POLICY_EXIT);
+  ASSERT_EQUAL(CCL_ERROR_EMULATOR_BOUND,status);
+  for(int c=0;c<6;c++) {
+    if(c==2) {
+      for(int i=0;i<EMU_NZ*NK_EMU;i++)
+	ASSERT_TRUE(isnan(pk_batch[c*EMU_NZ*NK_EMU+i]));
+      continue;
+    }
+    status=0;
+    ccl_pkemu_multiz(&(xstar[c*8]),EMU_NZ,zstar,pk_one,&status,cosmo);
+    ASSERT_EQUAL(0,status);
+    for(int i=0;i<EMU_NZ*NK_EMU;i++)
+      ASSERT_DBL_NEAR_TOL(pk_one[i],pk_batch[c*EMU_NZ*NK_EMU+i],1E-10*pk_one[i]);
+  }
+
+  free(pk_batch);
+  ccl_cosmology_free(cosmo);
+}
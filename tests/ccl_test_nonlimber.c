@@ -132,3 +132,180 @@ static void test_nonlimber_precision(struct nonlimber_data * data)
 CTEST2(nonlimber,precision) {
   test_nonlimber_precision(data);
 }
+
+// Checks that a non-Limber method reproduces the native one
+static void compare_nonlimber_native(struct nonlimber_data * data,int method)
+{
+  int status=0;
+  ccl_configuration ccl_config=default_config;
+  ccl_config.transfer_function_method=ccl_bbks;
+  ccl_config.matter_power_spectrum_method=ccl_linear;
+  ccl_parameters ccl_params = ccl_parameters_create(data->Omega_c, data->Omega_b, data->Omega_k, data->Neff, data->mnu, data->mnu_type,data->w_0, data->w_a, data->h, data->A_s, data->n_s,-1,-1,-1,-1,NULL,NULL, &status);
+  ccl_cosmology *ccl_cosmo=ccl_cosmology_create(ccl_params,ccl_config);
+
+  // Narrow bin (spectroscopic-like)
+  double z_arr[NZ],nz_arr[NZ],bz_arr[NZ],sz_arr[NZ];
+  for(int i=0;i<NZ;i++) {
+    z_arr[i]=Z0_GC-0.1+0.2*(i+0.5)/NZ;
+    nz_arr[i]=exp(-0.5*pow((z_arr[i]-Z0_GC)/0.02,2));
+    bz_arr[i]=1;
+    sz_arr[i]=0.2;
+  }
+
+  CCL_ClTracer *ct_gc_n=ccl_cl_tracer_number_counts(ccl_cosmo,1,1,NZ,z_arr,nz_arr,NZ,z_arr,bz_arr,NZ,z_arr,sz_arr,&status);
+  CCL_ClTracer *ct_gc_f=ccl_cl_tracer_number_counts(ccl_cosmo,1,1,NZ,z_arr,nz_arr,NZ,z_arr,bz_arr,NZ,z_arr,sz_arr,&status);
+  CCL_ClTracer *ct_wl_n=ccl_cl_tracer_lensing_simple(ccl_cosmo,NZ,z_arr,nz_arr,&status);
+  CCL_ClTracer *ct_wl_f=ccl_cl_tracer_lensing_simple(ccl_cosmo,NZ,z_arr,nz_arr,&status);
+  ASSERT_EQUAL(0,status);
+
+  int nl=199;
+  int ells[199];
+  double cl_gg_n[199],cl_gg_f[199],cl_gl_n[199],cl_gl_f[199],cl_ll_n[199],cl_ll_f[199];
+  for(int ii=0;ii<nl;ii++)
+    ells[ii]=ii+2;
+
+  // Non-Limber up to l=100, Limber beyond
+  CCL_ClWorkspace *wn=ccl_cl_workspace_default(ells[nl-1]+1,100,CCL_NONLIMBER_METHOD_NATIVE,
+					       1.05,20,3.,0.003,0.05,&status);
+  CCL_ClWorkspace *wf=ccl_cl_workspace_default(ells[nl-1]+1,100,method,
+					       1.05,20,3.,0.003,0.05,&status);
+  ASSERT_EQUAL(0,status);
+
+  ccl_angular_cls(ccl_cosmo,wn,ct_gc_n,ct_gc_n,nl,ells,cl_gg_n,&status);
+  ccl_angular_cls(ccl_cosmo,wn,ct_gc_n,ct_wl_n,nl,ells,cl_gl_n,&status);
+  ccl_angular_cls(ccl_cosmo,wn,ct_wl_n,ct_wl_n,nl,ells,cl_ll_n,&status);
+  ccl_angular_cls(ccl_cosmo,wf,ct_gc_f,ct_gc_f,nl,ells,cl_gg_f,&status);
+  ccl_angular_cls(ccl_cosmo,wf,ct_gc_f,ct_wl_f,nl,ells,cl_gl_f,&status);
+  ccl_angular_cls(ccl_cosmo,wf,ct_wl_f,ct_wl_f,nl,ells,cl_ll_f,&status);
+  ASSERT_EQUAL(0,status);
+
+  for(int ii=0;ii<nl;ii++) {
+    ASSERT_DBL_NEAR_TOL(1.,cl_gg_f[ii]/cl_gg_n[ii],1E-3);
+    ASSERT_DBL_NEAR_TOL(1.,cl_gl_f[ii]/cl_gl_n[ii],1E-3);
+    ASSERT_DBL_NEAR_TOL(1.,cl_ll_f[ii]/cl_ll_n[ii],1E-3);
+  }
+
+  // Transfer functions are recomputed when the same tracers are used with another method
+  ccl_angular_cls(ccl_cosmo,wn,ct_gc_f,ct_gc_f,nl,ells,cl_gg_f,&status);
+  ASSERT_EQUAL(0,status);
+  for(int ii=0;ii<nl;ii++)
+    ASSERT_DBL_NEAR_TOL(cl_gg_n[ii],cl_gg_f[ii],0.);
+
+  ccl_cl_tracer_free(ct_gc_n);
+  ccl_cl_tracer_free(ct_gc_f);
+  ccl_cl_tracer_free(ct_wl_n);
+  ccl_cl_tracer_free(ct_wl_f);
+  ccl_cl_workspace_free(wn);
+  ccl_cl_workspace_free(wf);
+  ccl_cosmology_free(ccl_cosmo);
+}
+
+CTEST2(nonlimber,fftlog) {
+  compare_nonlimber_native(data,CCL_NONLIMBER_METHOD_FFTLOG);
+}
+
+CTEST2(nonlimber,levin) {
+  compare_nonlimber_native(data,CCL_NONLIMBER_METHOD_LEVIN);
+}
+
+// Checks that the Levin integrator reproduces Limber's approximation for CMB lensing
+// at the multipoles where the latter is accurate
+CTEST2(nonlimber,levin_cmblens) {
+  int status=0;
+  ccl_configuration ccl_config=default_config;
+  ccl_config.transfer_function_method=ccl_bbks;
+  ccl_config.matter_power_spectrum_method=ccl_linear;
+  ccl_parameters ccl_params = ccl_parameters_create(data->Omega_c, data->Omega_b, data->Omega_k, data->Neff, data->mnu, data->mnu_type,data->w_0, data->w_a, data->h, data->A_s, data->n_s,-1,-1,-1,-1,NULL,NULL, &status);
+  ccl_cosmology *ccl_cosmo=ccl_cosmology_create(ccl_params,ccl_config);
+
+  CCL_ClTracer *ct_cl=ccl_cl_tracer_cmblens(ccl_cosmo,1100.,&status);
+  ASSERT_EQUAL(0,status);
+
+  int nl=151;
+  int ells[151];
+  double cl_lim[151],cl_lev[151];
+  for(int ii=0;ii<nl;ii++)
+    ells[ii]=ii+50;
+
+  CCL_ClWorkspace *wlim=ccl_cl_workspace_default_limber(ells[nl-1]+1,1.05,20,0.003,&status);
+  CCL_ClWorkspace *wlev=ccl_cl_workspace_default(ells[nl-1]+1,ells[nl-1],CCL_NONLIMBER_METHOD_LEVIN,
+						 1.05,20,3.,0.003,0.05,&status);
+  ASSERT_EQUAL(0,status);
+
+  ccl_angular_cls(ccl_cosmo,wlim,ct_cl,ct_cl,nl,ells,cl_lim,&status);
+  ccl_angular_cls(ccl_cosmo,wlev,ct_cl,ct_cl,nl,ells,cl_lev,&status);
+  ASSERT_EQUAL(0,status);
+
+  for(int ii=0;ii<nl;ii++)
+    ASSERT_DBL_NEAR_TOL(1.,cl_lev[ii]/cl_lim[ii],1E-2);
+
+  ccl_cl_tracer_free(ct_cl);
+  ccl_cl_workspace_free(wlim);
+  ccl_cl_workspace_free(wlev);
+  ccl_cosmology_free(ccl_cosmo);
+}
+
+// Runs a non-Limber method with a nonlinear power spectrum next to the native one.
+// FFTLog factorizes P(k,chi) around the effective distance of the kernels, so only
+// the narrow clustering bin (density and RSD) is used. The accuracy of this
+// factorization for nonlinear spectra has not been calibrated yet, so the largest
+// relative difference with the native method is logged rather than asserted.
+static void compare_nonlimber_native_halofit(struct nonlimber_data * data,int method)
+{
+  int status=0;
+  ccl_configuration ccl_config=default_config;
+  ccl_config.transfer_function_method=ccl_boltzmann_class;
+  ccl_config.matter_power_spectrum_method=ccl_halofit;
+  ccl_parameters ccl_params = ccl_parameters_create(data->Omega_c, data->Omega_b, data->Omega_k, data->Neff, data->mnu, data->mnu_type,data->w_0, data->w_a, data->h, data->A_s, data->n_s,-1,-1,-1,-1,NULL,NULL, &status);
+  ccl_cosmology *ccl_cosmo=ccl_cosmology_create(ccl_params,ccl_config);
+
+  double z_arr[NZ],nz_arr[NZ],bz_arr[NZ];
+  for(int i=0;i<NZ;i++) {
+    z_arr[i]=Z0_GC-0.1+0.2*(i+0.5)/NZ;
+    nz_arr[i]=exp(-0.5*pow((z_arr[i]-Z0_GC)/0.02,2));
+    bz_arr[i]=1;
+  }
+
+  CCL_ClTracer *ct_gc_n=ccl_cl_tracer_number_counts(ccl_cosmo,1,0,NZ,z_arr,nz_arr,NZ,z_arr,bz_arr,-1,NULL,NULL,&status);
+  CCL_ClTracer *ct_gc_f=ccl_cl_tracer_number_counts(ccl_cosmo,1,0,NZ,z_arr,nz_arr,NZ,z_arr,bz_arr,-1,NULL,NULL,&status);
+  ASSERT_EQUAL(0,status);
+
+  int nl=199;
+  int ells[199];
+  double cl_gg_n[199],cl_gg_f[199];
+  for(int ii=0;ii<nl;ii++)
+    ells[ii]=ii+2;
+
+  CCL_ClWorkspace *wn=ccl_cl_workspace_default(ells[nl-1]+1,100,CCL_NONLIMBER_METHOD_NATIVE,
+					       1.05,20,3.,0.003,0.05,&status);
+  CCL_ClWorkspace *wf=ccl_cl_workspace_default(ells[nl-1]+1,100,method,
+					       1.05,20,3.,0.003,0.05,&status);
+  ASSERT_EQUAL(0,status);
+
+  ccl_angular_cls(ccl_cosmo,wn,ct_gc_n,ct_gc_n,nl,ells,cl_gg_n,&status);
+  ccl_angular_cls(ccl_cosmo,wf,ct_gc_f,ct_gc_f,nl,ells,cl_gg_f,&status);
+  ASSERT_EQUAL(0,status);
+
+  double rdiff_max=0;
+  for(int ii=0;ii<nl;ii++) {
+    ASSERT_TRUE(cl_gg_n[ii]>0);
+    ASSERT_TRUE(cl_gg_f[ii]>0);
+    rdiff_max=fmax(rdiff_max,fabs(cl_gg_f[ii]/cl_gg_n[ii]-1));
+  }
+  CTEST_LOG("%s: largest relative difference with the native C_ell: %.2e",
+	    (method==CCL_NONLIMBER_METHOD_FFTLOG) ? "FFTLog" : "Levin",rdiff_max);
+
+  ccl_cl_tracer_free(ct_gc_n);
+  ccl_cl_tracer_free(ct_gc_f);
+  ccl_cl_workspace_free(wn);
+  ccl_cl_workspace_free(wf);
+  ccl_cosmology_free(ccl_cosmo);
+}
+
+CTEST2(nonlimber,fftlog_halofit) {
+  compare_nonlimber_native_halofit(data,CCL_NONLIMBER_METHOD_FFTLOG);
+}
+
+CTEST2(nonlimber,levin_halofit) {
+  compare_nonlimber_native_halofit(data,CCL_NONLIMBER_METHOD_LEVIN);
+}
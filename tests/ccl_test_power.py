@@ -161,5 +161,22 @@ def test_raise_error_emu_nonlin():
     transfer_fns = ['emulator',]
     for tfn in transfer_fns: loop_over_params(tfn, 'emu', lin=False, raise_errs = True)
 
+def test_power_spectrum_n_threads():
+    """
+    Check that the power spectrum tables don't depend on the number of
+    threads used to compute them.
+    """
+    k = np.logspace(-5., 1., 300)
+    for tfn in ['eisenstein_hu', 'bbks']:
+        pks = []
+        for n_threads in [1, 4]:
+            cosmo = ccl.Cosmology(Omega_c=Omega_c, Omega_b=Omega_b,
+                                  h=h, sigma8=sigma8, n_s=n_s,
+                                  transfer_function=tfn, n_threads=n_threads)
+            pks.append(ccl.linear_matter_power(cosmo, k, 0.5))
+        assert_(np.all(pks[0] == pks[1]))
+    assert_raises(ValueError, ccl.Cosmology, Omega_c=Omega_c,
+                  Omega_b=Omega_b, h=h, sigma8=sigma8, n_s=n_s, n_threads=-1)
+
 if __name__ == "__main__":
     run_module_suite(argv=sys.argv)
@@ -626,6 +626,27 @@ def check_cls(cosmo):
     # Check non-limber calculations
     assert_( all_finite(ccl.angular_cl(cosmo, nc1, nc1, ell_arr, l_limber=20, non_limber_method="native")))
     assert_( all_finite(ccl.angular_cl(cosmo, nc1, nc1, ell_arr, l_limber=20, non_limber_method="angpow")))
+    assert_( all_finite(ccl.angular_cl(cosmo, nc1, nc1, ell_arr, l_limber=20, non_limber_method="fftlog")))
+    assert_( all_finite(ccl.angular_cl(cosmo, nc1, nc1, ell_arr, l_limber=20, non_limber_method="levin")))
+    # Angpow can't do lensing, and falls back to another non-Limber method
+    cl_angpow = ccl.angular_cl(cosmo, lens1, nc1, ell_arr, l_limber=20, non_limber_method="angpow")
+    cl_native = ccl.angular_cl(cosmo, lens1, nc1, ell_arr, l_limber=20, non_limber_method="native")
+    assert_( np.allclose(cl_angpow, cl_native, rtol=1e-2, atol=0) )
+    if cmb_ok: assert_( all_finite(ccl.angular_cl(cosmo, cmbl, nc1, ell_arr, l_limber=20, non_limber_method="levin")))
+
+    # Check Limber integration methods
+    assert_( all_finite(ccl.angular_cl(cosmo, lens1, nc1, ell_arr, limber_method="grid")))
+    assert_raises(ValueError, ccl.angular_cl, cosmo, lens1, nc1, ell_arr, limber_method="xx")
+
+    # Check C_ell matrix of several tracers
+    cl_mat = ccl.angular_cl_matrix(cosmo, [lens1, nc1, nc2], ell_arr)
+    assert_( cl_mat.shape == (3, 3, ell_arr.size) )
+    assert_( all_finite(cl_mat) )
+    assert_( np.all(cl_mat[0, 1] == cl_mat[1, 0]) )
+    assert_( np.allclose(cl_mat[0, 1], ccl.angular_cl(cosmo, lens1, nc1, ell_arr, limber_method="grid"), rtol=1e-10, atol=0) )
+    cl_mat = ccl.angular_cl_matrix(cosmo, [lens1, nc1, nc2], ell_arr, limber_method="qag")
+    assert_( np.allclose(cl_mat[0, 1], ccl.angular_cl(cosmo, lens1, nc1, ell_arr), rtol=1e-10, atol=0) )
+    assert_( ccl.angular_cl_matrix(cosmo, [lens1, nc1], ell_scl).shape == (2, 2) )
 
     # Check various cross-correlation combinations
     assert_( all_finite(ccl.angular_cl(cosmo, lens1, lens2, ell_arr)) )
@@ -651,6 +672,42 @@ def check_cls(cosmo):
     # Wrong non limber method
     assert_raises(ValueError, ccl.angular_cl, cosmo, lens1, lens1, ell_scl, non_limber_method='xx')
 
+    # Check that rebinding a tracer to the same cosmology leaves it unchanged
+    cl_before = ccl.angular_cl(cosmo, lens1, nc3, ell_arr)
+    lens1.rebind(cosmo)
+    nc3.rebind(cosmo)
+    assert_( np.all(ccl.angular_cl(cosmo, lens1, nc3, ell_arr) == cl_before) )
+
+    # Check photo-z shift and stretch
+    lens1.set_photoz(cosmo, shift=0.05, stretch=1.1)
+    assert_( all_finite(ccl.angular_cl(cosmo, lens1, nc3, ell_arr)) )
+    lens1.set_photoz(cosmo)
+    assert_( np.all(ccl.angular_cl(cosmo, lens1, nc3, ell_arr) == cl_before) )
+    assert_raises(CCLError, lens1.set_photoz, cosmo, 0., -1.)
+    assert_raises(CCLError, cmbl.set_photoz, cosmo, 0.1)
+
+    # Check bias templates
+    cl_tmp = ccl.angular_cl_bias_templates(cosmo, nc3, lens1, ell_arr,
+                                           z_edges=[0., 0.5, 1.])
+    assert_( cl_tmp.shape == (4, 1, ell_arr.size) )
+    assert_( all_finite(cl_tmp) )
+    assert_( ccl.angular_cl_bias_templates(cosmo, nc1, nc1, ell_scl).shape == (1, 1) )
+    assert_raises(CCLError, ccl.angular_cl_bias_templates, cosmo, nc1, nc1,
+                  ell_arr, z_edges=[1., 0.])
+
+    # Check bandpowers against windows applied by hand
+    ell_bp = np.arange(100)
+    win = np.zeros([4, 100])
+    for ib in range(4):
+        win[ib, max(25 * ib, 2):25 * (ib + 1)] = 1.
+    win /= np.sum(win, axis=1)[:, None]
+    cl_bp = ccl.angular_cl(cosmo, lens1, nc1, ell_bp)
+    cb = ccl.angular_cl_bandpowers(cosmo, lens1, nc1, win)
+    assert_( cb.shape == (4,) )
+    assert_( np.allclose(cb, np.dot(win, cl_bp), rtol=1e-10, atol=0) )
+    assert_raises(ValueError, ccl.angular_cl_bandpowers, cosmo, lens1, nc1,
+                  win, ell=ell_bp[:10])
+
 
 
 def check_cls_nu(cosmo):
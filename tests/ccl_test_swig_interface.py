@@ -121,7 +121,7 @@ def test_swig_cls():
         None, None,
         1, 1, 1,
         0, 0, 0,
-        0,
+        0, 0, 0,
         [0, 1],
         5,
         status)
@@ -0,0 +1,159 @@
+#include "ccl.h"
+#include "ctest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define THREADS_NPOINTS 10000
+
+CTEST_DATA(threads) {
+  double Omega_c;
+  double Omega_b;
+  double h;
+  double A_s;
+  double n_s;
+  double sigma8;
+  double Neff;
+  double mnu;
+  ccl_mnu_convention mnu_type;
+};
+
+CTEST_SETUP(threads) {
+  data->Omega_c = 0.25;
+  data->Omega_b = 0.05;
+  data->h = 0.7;
+  data->A_s = 2.1e-9;
+  data->n_s = 0.96;
+  data->sigma8=0.8;
+  data->Neff=3.046;
+  data->mnu=0.;
+  data->mnu_type=ccl_mnu_sum;
+}
+
+// Evaluates the background and power spectrum at a set of points
+static void evaluate_all(ccl_cosmology *cosmo,int i,double *chi,double *a_chi,
+			 double *gf,double *fg,double *pk,int *status)
+{
+  double a=0.05+0.95*(i+0.5)/THREADS_NPOINTS;
+  double k=1E-3*pow(1E3,(i+0.5)/THREADS_NPOINTS);
+
+  chi[i]=ccl_comoving_radial_distance(cosmo,a,status);
+  a_chi[i]=ccl_scale_factor_of_chi(cosmo,chi[i],status);
+  gf[i]=ccl_growth_factor(cosmo,a,status);
+  fg[i]=ccl_growth_rate(cosmo,a,status);
+  pk[i]=ccl_linear_matter_power(cosmo,k,a,status);
+}
+
+// Checks that a computed cosmology gives the same results when
+// evaluated concurrently from several threads as when evaluated serially
+static void compare_threads(struct threads_data * data)
+{
+  int status=0;
+  ccl_configuration config = default_config;
+  config.transfer_function_method = ccl_bbks;
+  ccl_parameters params = ccl_parameters_create(data->Omega_c,data->Omega_b,0.0,data->Neff,
+						&(data->mnu),data->mnu_type,-1.0,0.0,data->h,
+						data->A_s,data->n_s,-1,-1,-1,-1,NULL,NULL,&status);
+  params.sigma8=data->sigma8;
+  ccl_cosmology * cosmo = ccl_cosmology_create(params, config);
+  ASSERT_NOT_NULL(cosmo);
+
+  //Tables must be computed before going parallel
+  ccl_cosmology_compute_distances(cosmo,&status);
+  ccl_cosmology_compute_growth(cosmo,&status);
+  ccl_cosmology_compute_power(cosmo,&status);
+  ASSERT_EQUAL(0,status);
+
+  double *serial=malloc(5*THREADS_NPOINTS*sizeof(double));
+  double *parallel=malloc(5*THREADS_NPOINTS*sizeof(double));
+  ASSERT_NOT_NULL(serial);
+  ASSERT_NOT_NULL(parallel);
+
+  for(int i=0;i<THREADS_NPOINTS;i++)
+    evaluate_all(cosmo,i,&(serial[0]),&(serial[THREADS_NPOINTS]),&(serial[2*THREADS_NPOINTS]),
+		 &(serial[3*THREADS_NPOINTS]),&(serial[4*THREADS_NPOINTS]),&status);
+  ASSERT_EQUAL(0,status);
+
+  int status_parallel=0;
+#pragma omp parallel for reduction(|:status_parallel)
+  for(int i=0;i<THREADS_NPOINTS;i++) {
+    int status_this=0;
+    //Interleave the order of evaluation so that threads jump around the tables
+    int j=(i%2) ? THREADS_NPOINTS-1-i/2 : i/2;
+    evaluate_all(cosmo,j,&(parallel[0]),&(parallel[THREADS_NPOINTS]),&(parallel[2*THREADS_NPOINTS]),
+		 &(parallel[3*THREADS_NPOINTS]),&(parallel[4*THREADS_NPOINTS]),&status_this);
+    status_parallel|=status_this;
+  }
+  ASSERT_EQUAL(0,status_parallel);
+
+  for(int i=0;i<5*THREADS_NPOINTS;i++)
+    ASSERT_DBL_NEAR_TOL(serial[i],parallel[i],0.);
+
+  free(serial);
+  free(parallel);
+  ccl_cosmology_free(cosmo);
+}
+
+CTEST2(threads,concurrent_evaluation) {
+  compare_threads(data);
+}
+
+// Computes the clustering and lensing C_ells with a given number of threads
+static void compute_cls(struct threads_data * data,int n_threads,int nl,int *ells,
+			double *cl_nc,double *cl_wl)
+{
+  int status=0;
+  ccl_configuration config = default_config;
+  config.transfer_function_method = ccl_bbks;
+  config.n_threads = n_threads;
+  ccl_parameters params = ccl_parameters_create(data->Omega_c,data->Omega_b,0.0,data->Neff,
+						&(data->mnu),data->mnu_type,-1.0,0.0,data->h,
+						data->A_s,data->n_s,-1,-1,-1,-1,NULL,NULL,&status);
+  params.sigma8=data->sigma8;
+  ccl_cosmology * cosmo = ccl_cosmology_create(params, config);
+  ASSERT_NOT_NULL(cosmo);
+
+  int nz=256;
+  double z[256],nofz[256],bz[256];
+  for(int i=0;i<nz;i++) {
+    z[i]=0.01+1.5*i/(nz-1.);
+    nofz[i]=exp(-0.5*pow((z[i]-0.7)/0.1,2));
+    bz[i]=1.;
+  }
+  CCL_ClTracer *tr_nc=ccl_cl_tracer_number_counts_simple(cosmo,nz,z,nofz,nz,z,bz,&status);
+  CCL_ClTracer *tr_wl=ccl_cl_tracer_lensing_simple(cosmo,nz,z,nofz,&status);
+  ASSERT_EQUAL(0,status);
+  CCL_ClWorkspace *w=ccl_cl_workspace_default_limber(ells[nl-1]+1,0.05,20,0.01,&status);
+  ASSERT_EQUAL(0,status);
+
+  ccl_angular_cls(cosmo,w,tr_nc,tr_nc,nl,ells,cl_nc,&status);
+  ccl_angular_cls(cosmo,w,tr_wl,tr_wl,nl,ells,cl_wl,&status);
+  ASSERT_EQUAL(0,status);
+
+  ccl_cl_workspace_free(w);
+  ccl_cl_tracer_free(tr_nc);
+  ccl_cl_tracer_free(tr_wl);
+  ccl_cosmology_free(cosmo);
+}
+
+// Checks that the C_ells computed in parallel are the same as the serial ones
+static void compare_cls_threads(struct threads_data * data)
+{
+  int nl=100;
+  int ells[100];
+  double cl_nc_1[100],cl_wl_1[100],cl_nc_4[100],cl_wl_4[100];
+  for(int i=0;i<nl;i++)
+    ells[i]=2+20*i;
+
+  compute_cls(data,1,nl,ells,cl_nc_1,cl_wl_1);
+  compute_cls(data,4,nl,ells,cl_nc_4,cl_wl_4);
+
+  for(int i=0;i<nl;i++) {
+    ASSERT_DBL_NEAR_TOL(cl_nc_1[i],cl_nc_4[i],0.);
+    ASSERT_DBL_NEAR_TOL(cl_wl_1[i],cl_wl_4[i],0.);
+  }
+}
+
+CTEST2(threads,angular_cls) {
+  compare_cls_threads(data);
+}
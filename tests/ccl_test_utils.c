@@ -64,3 +64,28 @@ CTEST(spherical_bessel_tests, compare_gsl) {
     }
   }
 }
+
+CTEST(spherical_bessel_tests, table_compare_gsl) {
+  int l, i;
+  double xmax = 10.0;
+  int Nx = 10000;
+  double x[10000], jl[10000];
+
+  for (i=0; i < Nx; ++i)
+    x[i] = 1.2 * xmax * i / (Nx - 1);
+
+  ccl_bessel_table *tab = ccl_bessel_table_new(0, 15, xmax, 0.2);
+  ASSERT_NOT_NULL(tab);
+
+  for (l=0; l < 15; ++l) {
+    ccl_bessel_table_eval_array(tab, l, Nx, x, jl);
+    for (i=0; i < Nx; ++i) {
+      // Points beyond the table are computed directly
+      if (x[i] > tab->xmax)
+        ASSERT_DBL_NEAR_TOL(ccl_j_bessel(l, x[i]), jl[i], 0.);
+      else
+        ASSERT_DBL_NEAR_TOL(gsl_sf_bessel_jl(l, x[i]), jl[i], 1e-4);
+    }
+  }
+  ccl_bessel_table_free(tab);
+}